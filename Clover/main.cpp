@@ -1,120 +1,279 @@
-﻿#include <iostream>
-
-#include "src/headers/colors.h"
-#include "src/headers/entity.h"
-#include "src/headers/base_component.h"
-#include "src/headers/event_system.h"
-#include "src/headers/store.h"
-#include "src/headers/core_components.h"
-#include "src/headers/glFunc.h"
-
-#include <glm/glm.hpp>
-#include <glm/gtc/matrix_transform.hpp>
-
-
-// Receive and handle keyboard events
-class Main_KBListener : public ce::Event::KbListener {
-public :
-    void receive(ce::Event::KbEvent event) {
-        if (event.action == ce::Event::CE_KEY_PRESSED) {
-            std::cout << " KEY PRESSED :   " << event.key << std::endl;
-        }
-        else if (event.action == ce::Event::CE_KEY_RELEASED) {
-            std::cout << " KEY RELEASED : " << event.key << std::endl;
-        }
-        else if (event.action == ce::Event::CE_KEY_HOLD) {
-            std::cout << " KEY HOLD : " << event.key << std::endl;
-        }
-    }
-};
-
-// Receive and handle mouse clicks events
-class Main_MouseActionListener : public ce::Event::MouseActionListener {
-public:
-    void receive(ce::Event::MouseActionEvent event) {
-        if (event.action == ce::Event::CE_MOUSE_PRESSED)
-        {
-            std::cout << "MOUSE PRESSED AT : " << event.mouse.x << "," << event.mouse.y << std::endl;
-        }
-        else if (event.action == ce::Event::CE_MOUSE_RELEASED) 
-        {
-            std::cout << "MOUSE RELEASED AT : " << event.mouse.x << "," << event.mouse.y << std::endl;
-        }     
-    }
-};
-
-
-int main()
-{
-    // Rendering
-    ce::Graphic::ceWindow w{ "Clover Engine - Test Window", 800, 600 };
-    auto renderer = w.getRendererPtr();
-
-    // Events
-    ce::Event::glEventSystem event_system{ renderer };
-
-    // World
-    ce::Core::Store store{};
-
-    // Creating an entity with a position component
-    auto game_entity_1 = ce::Core::Entity{0};
-    auto entity_1_position = std::make_unique<ce::Core::Node>(game_entity_1, 10, 10, 0);
-    auto entity_1_position_hndl = store.Add<ce::Core::Node>(std::move(entity_1_position)); // give component ownership to the store
-
-    // move the entity and verify we did not work on a copy by asking back a handle on the component
-    if (entity_1_position_hndl != nullptr) 
-    {
-        // move
-        entity_1_position_hndl->x = 20;
-        entity_1_position_hndl->y = 20;
-
-        // ask back handle
-        entity_1_position_hndl = store.Get<ce::Core::Node>(ce::Core::NODE_TYPE, game_entity_1);
-
-        if (entity_1_position_hndl != nullptr) 
-        {
-            std::cout << "Successfully retrieved the component from the store." << std::endl;
-
-            if (entity_1_position_hndl->x == 20 && entity_1_position_hndl->y == 20)
-                std::cout << "The move work correctly and you did not work on a copy." << std::endl;
-            else
-                std::cout << "something is wrong : values did not change and you worked on a copy." << std::endl;
-        }
-        else {
-            std::cout << "Something is wrong : the store Get() function returned a null pointer." << std::endl;
-        }
-    }
-
-    // Bind the keyboard event listener to the event system
-    Main_KBListener kb_main{};
-    event_system.bindKeyPressedListener(&kb_main);
-
-    // Bind the mouse clicks event listener to the event system
-    Main_MouseActionListener ma_main{};
-    event_system.bindMouseActionListener(&ma_main);
-    
-    // Start drawing operations
-    renderer->setClearColor(WHITE);
-
-
-    ce::Graphic::Triangle t{
-        ce::Core::fVec3{-1.0f, -1.0f, 0.0f},
-        ce::Core::fVec3{1.0f, -1.0f, 0.0f},
-        ce::Core::fVec3{0.0f, 1.0f, 0.0f}
-    };
-
-
-    // main loop
-    std::cout << "Window is open : " << w.isOpen() << std::endl;
-    
-    while (w.isOpen()) {
-        event_system.update(0); // update the event system
-        renderer->clear(); // clear the backbuffer
-        renderer->drawTriangle(t); // draw the triangle.
-        renderer->draw(); // swap the buffers !
-    }
-
-    ce::Graphic::GLFunc::Terminate();
-
-    return 0;
+﻿#include <chrono>
+#include <iostream>
+
+#include "src/headers/colors.h"
+#include "src/headers/entity.h"
+#include "src/headers/base_component.h"
+#include "src/headers/event_system.h"
+#include "src/headers/store.h"
+#include "src/headers/core_components.h"
+#include "src/headers/glFunc.h"
+#include "src/headers/mesh_file.h"
+#include "src/headers/coroutine.h"
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+
+// Receive and handle keyboard events
+class Main_KBListener : public ce::Event::KbListener {
+public :
+    void receive(ce::Event::KbEvent event) {
+        if (event.action == ce::Event::CE_KEY_PRESSED) {
+            std::cout << " KEY PRESSED :   " << event.key << std::endl;
+        }
+        else if (event.action == ce::Event::CE_KEY_RELEASED) {
+            std::cout << " KEY RELEASED : " << event.key << std::endl;
+        }
+        else if (event.action == ce::Event::CE_KEY_HOLD) {
+            std::cout << " KEY HOLD : " << event.key << std::endl;
+        }
+    }
+};
+
+// Receive and handle mouse clicks events
+class Main_MouseActionListener : public ce::Event::MouseActionListener {
+public:
+    void receive(ce::Event::MouseActionEvent event) {
+        if (event.action == ce::Event::CE_MOUSE_PRESSED)
+        {
+            std::cout << "MOUSE PRESSED AT : " << event.mouse.x << "," << event.mouse.y << std::endl;
+        }
+        else if (event.action == ce::Event::CE_MOUSE_RELEASED) 
+        {
+            std::cout << "MOUSE RELEASED AT : " << event.mouse.x << "," << event.mouse.y << std::endl;
+        }     
+    }
+};
+
+// Coroutine behaviour : wait without polling, resumed by the scheduler
+ce::Core::Task Main_Greeter() {
+    co_await ce::Core::Seconds{ 1.0 };
+    std::cout << "Clover engine has been running for one second." << std::endl;
+
+    auto shader = co_await ce::Core::LoadAsync{ "src/shaders/vertexshader.vshader" };
+    std::cout << "Loaded " << shader.size() << " bytes of vertex shader in the background." << std::endl;
+}
+
+
+int main(int argc, char** argv)
+{
+    // --record <file> saves the input stream, --replay <file> plays it back as a benchmark
+    // --headless runs without window nor GL, on synthetic input unless replaying, for --frames frames
+    // --crowd <n> adds n entities sharing one mesh, drawn with a single instanced call
+    // --render-thread executes the frames on a render thread while the next one is recorded
+    // --mesh <file> draws the crowd with a mesh baked by --bake-obj <obj file> <mesh file>
+    // --texture <file> loads a BMP or PPM texture in the background, repeat it to stream several
+    // --offscreen runs the GL path without display like --headless, --capture <file> saves its last frame as PPM
+    // --software draws on the CPU without GL, tiles spread over the job system, --capture works with it too
+    std::string record_path, replay_path;
+    bool headless = false;
+    bool offscreen = false;
+    bool software = false;
+    std::string capture_path;
+    std::size_t max_frames = 0;
+    std::size_t crowd = 0;
+    bool render_thread = false;
+    std::string mesh_path, bake_obj, bake_mesh;
+    std::vector<std::string> texture_paths;
+    for (int i = 1; i < argc; ++i) {
+        auto const arg = std::string{ argv[i] };
+        if (arg == "--headless") headless = true;
+        else if (arg == "--offscreen") offscreen = true;
+        else if (arg == "--software") software = true;
+        else if (i + 1 < argc && arg == "--capture") capture_path = argv[++i];
+        else if (arg == "--render-thread") render_thread = true;
+        else if (i + 1 < argc && arg == "--record") record_path = argv[++i];
+        else if (i + 1 < argc && arg == "--replay") replay_path = argv[++i];
+        else if (i + 1 < argc && arg == "--frames") max_frames = std::stoul(argv[++i]);
+        else if (i + 1 < argc && arg == "--crowd") crowd = std::stoul(argv[++i]);
+        else if (i + 1 < argc && arg == "--mesh") mesh_path = argv[++i];
+        else if (i + 1 < argc && arg == "--texture") texture_paths.push_back(argv[++i]);
+        else if (i + 2 < argc && arg == "--bake-obj") { bake_obj = argv[++i]; bake_mesh = argv[++i]; }
+    }
+
+    // offline conversion, no window
+    if (!bake_obj.empty())
+        return ce::Graphic::bake_obj(bake_obj, bake_mesh) ? 0 : 1;
+
+    // runs without anyone watching : synthetic input, bounded length and a summary
+    auto const unattended = headless || offscreen || software;
+
+    if (unattended && max_frames == 0 && replay_path.empty())
+        max_frames = 1000;
+
+    // Workers for the coroutines and the background file I/O
+    ce::Core::JobSystem jobs{};
+
+    // Linked shader programs kept between runs, read while the window opens
+    ce::Graphic::ProgramCache program_cache{ "shader_cache", &jobs };
+    program_cache.warm();
+    ce::Graphic::GLFunc::SetProgramCache(&program_cache);
+
+    // Rendering
+    auto const backend = headless ? ce::Graphic::RenderBackend::HEADLESS
+        : offscreen ? ce::Graphic::RenderBackend::OFFSCREEN
+        : software ? ce::Graphic::RenderBackend::SOFTWARE : ce::Graphic::RenderBackend::GLFW;
+    ce::Graphic::ceWindow w{ "Clover Engine - Test Window", 800, 600, backend };
+    auto renderer = w.getRendererPtr();
+
+    // textures decode on the workers and upload a few per frame, the software tiles rasterize on them
+    renderer->setJobSystem(&jobs);
+    for (auto const& path : texture_paths)
+        renderer->loadTexture(path);
+
+    // Events
+    ce::Event::glEventSystem event_system{ renderer };
+
+    ce::Event::SyntheticEventSource synthetic_events{ 42 };
+    if (unattended)
+        event_system.setEventSource(&synthetic_events);
+
+    std::unique_ptr<ce::Event::InputRecorder> recorder;
+    std::unique_ptr<ce::Event::InputReplay> replay;
+
+    if (!record_path.empty()) {
+        recorder = std::make_unique<ce::Event::InputRecorder>(record_path);
+        event_system.setRecorder(recorder.get());
+    }
+
+    if (!replay_path.empty()) {
+        replay = std::make_unique<ce::Event::InputReplay>(replay_path);
+        event_system.setEventSource(replay.get());
+    }
+
+    // World
+    ce::Core::Store store{};
+
+    // Coroutines, resumed once per frame
+    ce::Core::Scheduler scheduler{ &jobs };
+
+    // Creating an entity with a position component
+    auto game_entity_1 = ce::Core::Entity{0};
+    auto entity_1_position = std::make_unique<ce::Core::Node>(game_entity_1, 10, 10, 0);
+    auto entity_1_position_hndl = store.Add<ce::Core::Node>(std::move(entity_1_position)); // give component ownership to the store
+
+    // move the entity and verify we did not work on a copy by asking back a handle on the component
+    if (entity_1_position_hndl != nullptr) 
+    {
+        // move
+        entity_1_position_hndl->x = 20;
+        entity_1_position_hndl->y = 20;
+
+        // ask back handle
+        entity_1_position_hndl = store.Get<ce::Core::Node>(ce::Core::NODE_TYPE, game_entity_1);
+
+        if (entity_1_position_hndl != nullptr) 
+        {
+            std::cout << "Successfully retrieved the component from the store." << std::endl;
+
+            if (entity_1_position_hndl->x == 20 && entity_1_position_hndl->y == 20)
+                std::cout << "The move work correctly and you did not work on a copy." << std::endl;
+            else
+                std::cout << "something is wrong : values did not change and you worked on a copy." << std::endl;
+        }
+        else {
+            std::cout << "Something is wrong : the store Get() function returned a null pointer." << std::endl;
+        }
+    }
+
+    // A crowd of small triangles on a grid, every entity uses the same mesh
+    auto crowd_mesh = mesh_path.empty() ? ce::Graphic::CE_INVALID_MESH : renderer->loadMesh(mesh_path);
+
+    if (crowd_mesh == ce::Graphic::CE_INVALID_MESH)
+        crowd_mesh = renderer->addMesh({
+            ce::Core::fVec3{-0.01f, -0.01f, 0.0f},
+            ce::Core::fVec3{0.01f, -0.01f, 0.0f},
+            ce::Core::fVec3{0.0f, 0.01f, 0.0f}
+        });
+
+    for (std::size_t i = 0; i < crowd; ++i) {
+        auto const entity = ce::Core::Entity{ i + 1 };
+        auto const x = -0.9f + 1.8f * static_cast<float>(i % 100) / 100.0f;
+        auto const y = -0.9f + 1.8f * static_cast<float>((i / 100) % 100) / 100.0f;
+
+        store.Add<ce::Core::Node>(std::make_unique<ce::Core::Node>(entity, x, y, 0.0f));
+        store.Add<ce::Core::Renderable>(std::make_unique<ce::Core::Renderable>(entity, crowd_mesh, RED));
+        store.Add<ce::Core::Bounds>(std::make_unique<ce::Core::Bounds>(entity, 0.015f));
+    }
+
+    // Bind the keyboard event listener to the event system
+    Main_KBListener kb_main{};
+    event_system.bindKeyPressedListener(&kb_main);
+
+    // Bind the mouse clicks event listener to the event system
+    Main_MouseActionListener ma_main{};
+    event_system.bindMouseActionListener(&ma_main);
+    
+    // Start drawing operations
+    renderer->setClearColor(WHITE);
+
+    if (render_thread)
+        renderer->startRenderThread();
+    scheduler.start(Main_Greeter());
+
+
+    ce::Graphic::Triangle t{
+        ce::Core::fVec3{-1.0f, -1.0f, 0.0f},
+        ce::Core::fVec3{1.0f, -1.0f, 0.0f},
+        ce::Core::fVec3{0.0f, 1.0f, 0.0f}
+    };
+
+
+    // main loop
+    std::cout << "Window is open : " << w.isOpen() << std::endl;
+    
+    auto last_frame = std::chrono::steady_clock::now();
+    auto const replay_start = last_frame;
+    std::size_t frame_count = 0;
+
+    while (w.isOpen() && !(replay && replay->done()) && !(max_frames != 0 && frame_count == max_frames)) {
+        ++frame_count;
+
+        auto const now = std::chrono::steady_clock::now();
+        auto frame_ms = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(now - last_frame).count());
+        last_frame += std::chrono::milliseconds(frame_ms); // keep the remainder for the next frame
+
+        // replays and unattended runs use a fixed step so every run simulates the same frames
+        if (replay || unattended)
+            frame_ms = 16;
+
+        event_system.update(frame_ms); // update the event system
+        scheduler.update(frame_ms); // resume the coroutines
+        renderer->clear(); // clear the backbuffer
+        renderer->drawTriangle(t); // draw the triangle.
+        renderer->drawEntities(store); // draw the crowd, one call per mesh
+        renderer->draw(); // swap the buffers !
+    }
+
+    // the last frame is drawn and the context is back on this thread
+    renderer->stopRenderThread();
+
+    // the frame to compare with a reference image
+    if (!capture_path.empty()) {
+        ce::Graphic::Image frame;
+        if (renderer->capture(frame) && ce::Graphic::save_image(capture_path, frame))
+            std::cout << "Saved the last frame to " << capture_path << std::endl;
+    }
+
+    if (replay || unattended) {
+        auto const total = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - replay_start).count();
+        std::cout << "Ran " << frame_count << " frames, average frame time : "
+            << (frame_count > 0 ? total / frame_count : 0.0) << " ms" << std::endl;
+
+        auto const& stats = renderer->stats();
+        std::cout << "Render commands : " << stats.commands << ", draw calls : " << stats.draw_calls
+            << ", triangles : " << stats.triangles << ", state changes : " << stats.state_changes
+            << ", redundant GL calls skipped : " << stats.redundant_calls
+            << ", submissions : " << stats.submissions << ", culled : " << stats.culled << std::endl;
+
+        // CPU bound when the CPU time of the passes exceeds their GPU time, GPU bound otherwise
+        for (auto const& zone : renderer->frameTimings())
+            std::cout << "  " << zone.name << " : cpu " << zone.cpu_ms << " ms, gpu " << zone.gpu_ms
+                << " ms, " << zone.calls << (zone.calls > 1 ? " calls" : " call") << std::endl;
+    }
+
+    ce::Graphic::GLFunc::Terminate();
+
+    return 0;
 }
\ No newline at end of file
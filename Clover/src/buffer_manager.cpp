@@ -0,0 +1,181 @@
+#include <assert.h>
+
+#include "headers/buffer_manager.h"
+#include "headers/glFunc.h"
+
+namespace ce {
+	namespace Graphic {
+
+		/// <summary>
+		///		Constructor
+		/// </summary>
+		BufferManager::BufferManager()
+			: Buffers_{}, Free_{}, AllocatedBytes_{ 0 }
+		{}
+
+		/// <summary>
+		///		Destructor. Give every buffer back to the driver.
+		/// </summary>
+		BufferManager::~BufferManager()
+		{
+			clear();
+		}
+
+		/// <summary>
+		///		Move constructor
+		/// </summary>
+		/// <param name="other">Manager to move, left empty</param>
+		BufferManager::BufferManager(BufferManager&& other) noexcept
+			: Buffers_{ std::move(other.Buffers_) },
+			Free_{ std::move(other.Free_) },
+			AllocatedBytes_{ other.AllocatedBytes_ }
+		{
+			other.Buffers_.clear();
+			other.Free_.clear();
+			other.AllocatedBytes_ = 0;
+		}
+
+		/// <summary>
+		///		Move assignement
+		/// </summary>
+		/// <param name="other">Manager to move, left empty</param>
+		BufferManager& BufferManager::operator=(BufferManager&& other) noexcept
+		{
+			if (this != &other)
+			{
+				clear();
+
+				Buffers_ = std::move(other.Buffers_);
+				Free_ = std::move(other.Free_);
+				AllocatedBytes_ = other.AllocatedBytes_;
+
+				other.Buffers_.clear();
+				other.Free_.clear();
+				other.AllocatedBytes_ = 0;
+			}
+
+			return *this;
+		}
+
+		/// <summary>
+		///		Create a buffer, reusing a destroyed one when possible
+		/// </summary>
+		/// <param name="target">GL_ARRAY_BUFFER, GL_ELEMENT_ARRAY_BUFFER...</param>
+		/// <param name="usage">Update frequency</param>
+		/// <param name="size">Size in bytes</param>
+		/// <param name="data">Initial content, may be null</param>
+		/// <returns>Handle on the buffer</returns>
+		BufferHandle BufferManager::create(GLenum target, BufferUsage usage, GLsizeiptr size, const void* data)
+		{
+			BufferHandle handle;
+
+			if (!Free_.empty())
+			{
+				// keep the GL name, the storage is specified again below
+				handle = Free_.back();
+				Free_.pop_back();
+			}
+			else
+			{
+				handle = Buffers_.size();
+				Buffers_.push_back(Buffer{ GLFunc::GenBuffer(), target, usage, 0, 0, false });
+			}
+
+			auto& b = Buffers_[handle];
+			AllocatedBytes_ += size - b.capacity;
+
+			b.target = target;
+			b.usage = usage;
+			b.capacity = size;
+			b.size = size;
+			b.alive = true;
+
+			GLFunc::BindBuffer(target, b.id);
+			GLFunc::BufferData(target, size, data, gl_usage(usage));
+
+			return handle;
+		}
+
+		/// <summary>
+		///		Replace the content of a buffer. The storage is only reallocated when the data
+		///		does not fit. Stream and dynamic buffers are orphaned first, so the driver
+		///		hands out fresh memory instead of waiting for the draws still reading the old one.
+		/// </summary>
+		/// <param name="buffer">Buffer to update</param>
+		/// <param name="size">Size in bytes</param>
+		/// <param name="data">New content</param>
+		void BufferManager::update(BufferHandle buffer, GLsizeiptr size, const void* data)
+		{
+			assert(buffer < Buffers_.size() && Buffers_[buffer].alive && "Invalid buffer handle.");
+
+			auto& b = Buffers_[buffer];
+			GLFunc::BindBuffer(b.target, b.id);
+
+			if (size > b.capacity)
+			{
+				// grow with some headroom to avoid reallocating on every small growth
+				auto const capacity = b.usage == BufferUsage::STATIC ? size : size + size / 2;
+
+				AllocatedBytes_ += capacity - b.capacity;
+				b.capacity = capacity;
+
+				GLFunc::BufferData(b.target, capacity, nullptr, gl_usage(b.usage));
+			}
+			else if (b.usage != BufferUsage::STATIC)
+			{
+				GLFunc::BufferData(b.target, b.capacity, nullptr, gl_usage(b.usage));
+			}
+
+			GLFunc::BufferSubData(b.target, 0, size, data);
+			b.size = size;
+		}
+
+		/// <summary>
+		///		Release a buffer. Its GL name is kept for the next create.
+		/// </summary>
+		void BufferManager::destroy(BufferHandle buffer)
+		{
+			if (buffer >= Buffers_.size() || !Buffers_[buffer].alive)
+				return;
+
+			Buffers_[buffer].alive = false;
+			Buffers_[buffer].size = 0;
+			Free_.push_back(buffer);
+		}
+
+		/// <summary>
+		///		Delete every GL buffer
+		/// </summary>
+		void BufferManager::clear()
+		{
+			// the context may already be gone at shutdown, the buffers went with it
+			if (GLFunc::IsReady())
+				for (auto const& b : Buffers_)
+					GLFunc::DeleteBuffer(b.id);
+
+			Buffers_.clear();
+			Free_.clear();
+			AllocatedBytes_ = 0;
+		}
+
+		GLuint BufferManager::id(BufferHandle buffer) const
+		{
+			return buffer < Buffers_.size() ? Buffers_[buffer].id : 0;
+		}
+
+		GLsizeiptr BufferManager::size(BufferHandle buffer) const
+		{
+			return buffer < Buffers_.size() ? Buffers_[buffer].size : 0;
+		}
+
+		GLenum BufferManager::gl_usage(BufferUsage usage)
+		{
+			switch (usage)
+			{
+			case BufferUsage::STATIC: return GL_STATIC_DRAW;
+			case BufferUsage::DYNAMIC: return GL_DYNAMIC_DRAW;
+			default: return GL_STREAM_DRAW;
+			}
+		}
+	}
+}
@@ -0,0 +1,368 @@
+#include <fstream>
+#include <new>
+#include <sstream>
+
+#include "headers/coroutine.h"
+
+namespace ce {
+	namespace Core {
+
+		namespace {
+			// frames are rounded up to 64 bytes, bigger frames go straight to the heap
+			const std::size_t CE_FRAME_GRANULARITY = 64;
+			const std::size_t CE_FRAME_CLASSES = 16;
+			const std::size_t CE_FRAME_CHUNK = 16;
+
+			struct FreeFrame {
+				FreeFrame* next;
+			};
+
+			// one free list by size class and by thread, no lock needed
+			thread_local FreeFrame* FreeFrames[CE_FRAME_CLASSES] = {};
+
+			std::size_t frame_class(std::size_t size)
+			{
+				return (size + CE_FRAME_GRANULARITY - 1) / CE_FRAME_GRANULARITY - 1;
+			}
+		}
+
+		/// <summary>
+		///		Get a frame from the pool, refill the pool by chunks when it is empty
+		/// </summary>
+		/// <param name="size">Frame size requested by the compiler</param>
+		void* FramePool::allocate(std::size_t size)
+		{
+			auto const c = frame_class(size);
+
+			if (c >= CE_FRAME_CLASSES)
+				return ::operator new(size);
+
+			if (FreeFrames[c] == nullptr)
+			{
+				auto const block = (c + 1) * CE_FRAME_GRANULARITY;
+				auto chunk = static_cast<char*>(::operator new(block * CE_FRAME_CHUNK));
+
+				// chunks are never given back, frames are recycled for the process lifetime
+				for (std::size_t i = 0; i < CE_FRAME_CHUNK; ++i)
+				{
+					auto frame = reinterpret_cast<FreeFrame*>(chunk + i * block);
+					frame->next = FreeFrames[c];
+					FreeFrames[c] = frame;
+				}
+			}
+
+			auto frame = FreeFrames[c];
+			FreeFrames[c] = frame->next;
+			return frame;
+		}
+
+		/// <summary>
+		///		Give a frame back to the pool
+		/// </summary>
+		/// <param name="frame">Frame to release</param>
+		/// <param name="size">Frame size, same as the allocation</param>
+		void FramePool::release(void* frame, std::size_t size)
+		{
+			auto const c = frame_class(size);
+
+			if (c >= CE_FRAME_CLASSES)
+			{
+				::operator delete(frame);
+				return;
+			}
+
+			auto f = static_cast<FreeFrame*>(frame);
+			f->next = FreeFrames[c];
+			FreeFrames[c] = f;
+		}
+
+		/// <summary>
+		///		Destructor. Destroy the coroutine frame if the task still owns it.
+		/// </summary>
+		Task::~Task()
+		{
+			if (Handle_)
+				Handle_.destroy();
+		}
+
+		/// <summary>
+		///		Move constructor
+		/// </summary>
+		/// <param name="other">Task to move</param>
+		Task::Task(Task&& other) noexcept
+			: Handle_{ other.release() }
+		{}
+
+		/// <summary>
+		///		Move assignement
+		/// </summary>
+		/// <param name="other">Task to move</param>
+		Task& Task::operator=(Task&& other) noexcept
+		{
+			if (this != &other)
+			{
+				if (Handle_)
+					Handle_.destroy();
+
+				Handle_ = other.release();
+			}
+
+			return *this;
+		}
+
+		/// <summary>
+		///		Give up the frame ownership
+		/// </summary>
+		Task::Handle Task::release()
+		{
+			auto h = Handle_;
+			Handle_ = {};
+			return h;
+		}
+
+		/// <summary>
+		///		Start the awaited task, it resumes the caller when it ends
+		/// </summary>
+		/// <param name="caller">Task awaiting this one</param>
+		std::coroutine_handle<> Task::await_suspend(Handle caller) noexcept
+		{
+			auto& p = Handle_.promise();
+			p.Scheduler_ = caller.promise().Scheduler_;
+			p.Continuation_ = caller;
+
+			return Handle_;
+		}
+
+		/// <summary>
+		///		Forward the exception thrown by the awaited task
+		/// </summary>
+		void Task::await_resume()
+		{
+			if (Handle_ && Handle_.promise().Exception_)
+				std::rethrow_exception(Handle_.promise().Exception_);
+		}
+
+		/// <summary>
+		///		Jump back to the awaiting task or release a finished root task
+		/// </summary>
+		/// <param name="h">Task that just ended</param>
+		std::coroutine_handle<> Task::FinalAwaiter::await_suspend(Handle h) noexcept
+		{
+			auto& p = h.promise();
+
+			if (p.Continuation_)
+				return p.Continuation_;
+
+			// root task : nobody will look at this frame anymore
+			if (p.Scheduler_ != nullptr)
+				p.Scheduler_->retire(&p);
+
+			h.destroy();
+			return std::noop_coroutine();
+		}
+
+		/// <summary>
+		///		Park the task until the next update
+		/// </summary>
+		void NextFrame::await_suspend(Task::Handle h) noexcept
+		{
+			h.promise().Scheduler_->parkNextFrame(&h.promise());
+		}
+
+		/// <summary>
+		///		Park the task until the scheduler clock reaches the wake time
+		/// </summary>
+		void Seconds::await_suspend(Task::Handle h) noexcept
+		{
+			auto& p = h.promise();
+			p.WakeTime_ = p.Scheduler_->Time_ + Duration;
+			p.Scheduler_->parkTimer(&p);
+		}
+
+		/// <summary>
+		///		Read the file on a worker and park the task until it is done.
+		///		Without job system the file is read in place and the task does not suspend.
+		/// </summary>
+		bool LoadAsync::await_suspend(Task::Handle h)
+		{
+			auto load = [this]() {
+				std::ifstream stream(Path_, std::ios::in | std::ios::binary);
+
+				if (stream.is_open()) {
+					std::stringstream sstr;
+					sstr << stream.rdbuf();
+					Content_ = sstr.str();
+				}
+			};
+
+			auto scheduler = h.promise().Scheduler_;
+
+			if (scheduler->Jobs_ == nullptr)
+			{
+				load();
+				return false;
+			}
+
+			auto p = &h.promise();
+			scheduler->Jobs_->submit([load, scheduler, p]() {
+				load();
+				scheduler->parkLoaded(p);
+			});
+
+			return true;
+		}
+
+		/// <summary>
+		///		Constructor
+		/// </summary>
+		/// <param name="jobs">Job system used to load files, may be null</param>
+		Scheduler::Scheduler(JobSystem* jobs)
+			: Jobs_{ jobs },
+			Roots_{ nullptr },
+			NextFrame_{ nullptr },
+			Timers_{ nullptr },
+			Loaded_{ nullptr },
+			Failed_{},
+			Time_{ 0.0 },
+			Frame_{ 0 },
+			Running_{ 0 }
+		{}
+
+		/// <summary>
+		///		Destructor. Destroy the tasks that did not finish.
+		/// </summary>
+		Scheduler::~Scheduler()
+		{
+			// pending loads write into the frames, let them land first
+			if (Jobs_ != nullptr)
+				Jobs_->wait();
+
+			while (Roots_ != nullptr)
+			{
+				auto p = Roots_;
+				Roots_ = p->RootNext_;
+				Task::Handle::from_promise(*p).destroy();
+			}
+		}
+
+		/// <summary>
+		///		Take ownership of a task and run it until it suspends
+		/// </summary>
+		/// <param name="task">Task to run</param>
+		void Scheduler::start(Task task)
+		{
+			auto h = task.release();
+
+			if (!h)
+				return;
+
+			auto p = &h.promise();
+			p->Scheduler_ = this;
+			p->Continuation_ = {};
+
+			p->RootPrev_ = nullptr;
+			p->RootNext_ = Roots_;
+			if (Roots_ != nullptr)
+				Roots_->RootPrev_ = p;
+			Roots_ = p;
+
+			++Running_;
+
+			resume(p);
+		}
+
+		/// <summary>
+		///		Advance the clock and resume the tasks whose wait is over
+		/// </summary>
+		/// <param name="time_delta">Time elapsed since the last update, in milliseconds</param>
+		void Scheduler::update(int time_delta)
+		{
+			Time_ += time_delta / 1000.0;
+			++Frame_;
+
+			// detach the list first, tasks awaiting NextFrame again wait for the next update
+			auto p = NextFrame_;
+			NextFrame_ = nullptr;
+
+			while (p != nullptr)
+			{
+				auto next = p->Next_;
+				resume(p);
+				p = next;
+			}
+
+			while (Timers_ != nullptr && Timers_->WakeTime_ <= Time_)
+			{
+				auto t = Timers_;
+				Timers_ = t->Next_;
+				resume(t);
+			}
+
+			p = Loaded_.exchange(nullptr, std::memory_order_acquire);
+
+			while (p != nullptr)
+			{
+				auto next = p->Next_;
+				resume(p);
+				p = next;
+			}
+
+			if (Failed_)
+			{
+				auto e = Failed_;
+				Failed_ = nullptr;
+				std::rethrow_exception(e);
+			}
+		}
+
+		void Scheduler::parkNextFrame(Promise* p)
+		{
+			p->Next_ = NextFrame_;
+			NextFrame_ = p;
+		}
+
+		void Scheduler::parkTimer(Promise* p)
+		{
+			// keep the timers sorted, the update only looks at the head
+			auto link = &Timers_;
+
+			while (*link != nullptr && (*link)->WakeTime_ <= p->WakeTime_)
+				link = &(*link)->Next_;
+
+			p->Next_ = *link;
+			*link = p;
+		}
+
+		void Scheduler::parkLoaded(Promise* p)
+		{
+			// called from the workers
+			auto head = Loaded_.load(std::memory_order_relaxed);
+
+			do {
+				p->Next_ = head;
+			} while (!Loaded_.compare_exchange_weak(head, p, std::memory_order_release, std::memory_order_relaxed));
+		}
+
+		void Scheduler::resume(Promise* p)
+		{
+			p->Next_ = nullptr;
+			Task::Handle::from_promise(*p).resume();
+		}
+
+		void Scheduler::retire(Promise* p)
+		{
+			if (p->RootPrev_ != nullptr)
+				p->RootPrev_->RootNext_ = p->RootNext_;
+			else
+				Roots_ = p->RootNext_;
+
+			if (p->RootNext_ != nullptr)
+				p->RootNext_->RootPrev_ = p->RootPrev_;
+
+			if (p->Exception_ && !Failed_)
+				Failed_ = p->Exception_;
+
+			--Running_;
+		}
+	}
+}
@@ -0,0 +1,86 @@
+#include <atomic>
+
+#include "headers/event_bus.h"
+
+namespace ce {
+	namespace Event {
+
+		/// <summary>
+		///		Next free event type id
+		/// </summary>
+		EventTypeId EventTypeIds::next()
+		{
+			static std::atomic<EventTypeId> counter{ 0 };
+			return counter.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		/// <summary>
+		///		Constructor
+		/// </summary>
+		EventBus::EventBus()
+			: Channels_{}, Pending_{}, Flushing_{},
+			Posted_{ std::make_unique<PostedEventQueue>() },
+			DroppedPosts_{ 0 }
+		{}
+
+		/// <summary>
+		///		Move constructor
+		/// </summary>
+		/// <param name="other">Bus to move</param>
+		EventBus::EventBus(EventBus&& other) noexcept
+			: Channels_{ std::move(other.Channels_) },
+			Pending_{ std::move(other.Pending_) },
+			Flushing_{ std::move(other.Flushing_) },
+			Posted_{ std::move(other.Posted_) },
+			DroppedPosts_{ other.DroppedPosts_.load() }
+		{}
+
+		/// <summary>
+		///		Move assignement
+		/// </summary>
+		/// <param name="other">Bus to move</param>
+		EventBus& EventBus::operator=(EventBus&& other) noexcept
+		{
+			Channels_ = std::move(other.Channels_);
+			Pending_ = std::move(other.Pending_);
+			Flushing_ = std::move(other.Flushing_);
+			Posted_ = std::move(other.Posted_);
+			DroppedPosts_ = other.DroppedPosts_.load();
+
+			return *this;
+		}
+
+		/// <summary>
+		///		Publish every queued event. Events queued by the delegates are kept for the next flush.
+		/// </summary>
+		void EventBus::flush()
+		{
+			Flushing_.swap(Pending_);
+
+			for (auto channel : Flushing_)
+				channel->flush();
+
+			Flushing_.clear();
+		}
+
+		/// <summary>
+		///		Publish the events posted by the other threads. Only the events
+		///		fully posted when the drain starts are guaranteed to be published.
+		/// </summary>
+		/// <returns>Number of published events</returns>
+		std::size_t EventBus::drainPosted()
+		{
+			// bounded by the capacity, events posted during the drain may wait for the next one
+			std::size_t count = 0;
+			PostedEvent posted;
+
+			while (count < CE_POSTED_EVENT_QUEUE_SIZE && Posted_->pop(posted))
+			{
+				posted.deliver(*this, posted.data);
+				++count;
+			}
+
+			return count;
+		}
+	}
+}
@@ -1,196 +1,532 @@
-#include "headers/event_system.h"
-
-namespace ce {
-	namespace Event {
-
-		/// <summary>
-		///		Constructor. This event system may only be binded once to a window. Unbinded event system won't dispatch events. Use 1 event system by window.
-		/// </summary>
-		/// <param name="w">Window from which the event system will receive events</param>
-		glEventSystem::glEventSystem(ce::Graphic::ceWindow::ceRenderer* w)
-		{
-			if (w)
-			{
-				auto const window = w->GetContextWindow();
-				// see if there is already an event system pointer for this window
-				auto es = static_cast<glEventSystem*>(glfwGetWindowUserPointer(window));
-
-				if (es == nullptr) { // just 1 event system by window !
-
-					// store a pointer on this event class into glfw
-					// to get it back into the callbacks
-					glfwSetWindowUserPointer(window, this);
-
-					glfwSetKeyCallback(window, kb_action_callback);
-					glfwSetCursorPosCallback(window, mouse_moved_callback);
-					glfwSetMouseButtonCallback(window, mouse_action_callback);
-					glfwSetWindowSizeCallback(window, window_resized_callback);
-
-					bindedWindow_ = w;
-					return;
-				}
-			}
-
-			bindedWindow_ = nullptr;
-		}
-
-		/// <summary>
-		///		Move constructor
-		/// </summary>
-		/// <param name="other">Event system to move</param>
-		glEventSystem::glEventSystem(glEventSystem&& other) noexcept 
-		:	KeyboardListeners_{std::move(other.KeyboardListeners_)},
-			bindedWindow_{other.bindedWindow_}
-		{}
-
-		/// <summary>
-		///		Move assignement
-		/// </summary>
-		/// <param name="other">Event system to move</param>
-		glEventSystem& glEventSystem::operator=(glEventSystem&& other) noexcept
-		{
-			KeyboardListeners_ = std::move(other.KeyboardListeners_);
-			bindedWindow_ = other.bindedWindow_;
-
-			return *this;
-		}
-
-		/// <summary>
-		///		Bind a keyboard listener to receive keyboard events
-		/// </summary>
-		/// <param name="listener">The listener to bind to this system</param>
-		void glEventSystem::bindKeyPressedListener(KbListener* listener)
-		{
-			if (listener != nullptr)
-				KeyboardListeners_.push_back(listener);
-		};
-
-		/// <summary>
-		///		Bind a mouse moved listener to receive mouse the new mouse position
-		/// </summary>
-		/// <param name="listener">The listener to bind to this system</param>
-		void glEventSystem::bindMouseMovedListener(MouseMovedListener* listener)
-		{
-			if (listener != nullptr)
-				MouseMovedListeners_.push_back(listener);
-		};
-
-		/// <summary>
-		///		Bind a mouse action listener to receive mouse button release/press and position
-		/// </summary>
-		/// <param name="listener">The listener to bind to this system</param>
-		void glEventSystem::bindMouseActionListener(MouseActionListener* listener)
-		{
-			if (listener != nullptr)
-				MouseActionListeners_.push_back(listener);
-		};
-
-
-		/// <summary>
-		///		Poll and send the events
-		/// </summary>
-		/// <param name="time_delta">Time elapsed since the last call for update control</param>
-		void glEventSystem::update(int time_delta)
-		{
-			// do not poll events if the system is not binded to window
-			// which happens when trying to bind 2 glEventSystem to a same window
-			if (bindedWindow_ != nullptr)
-				glfwPollEvents();
-		}
-
-		/// <summary>
-		///		Send the keyboard action to the listeners
-		/// </summary>
-		void glEventSystem::sendKbEvent(GLFWwindow* window, int key, int scancode, int action, int mods)
-		{
-			for (auto listener : KeyboardListeners_) {
-				listener->receive(KbEvent{ action,key });
-			}
-		}
-		
-		/// <summary>
-		///		GLFW keyboard action callback
-		/// </summary>
-		void glEventSystem::kb_action_callback(GLFWwindow* window, int key, int scancode, int action, int mods)
-		{
-			// get back the pointer on this system stored by glfw (see constructor)
-			// to send the action to the listeners
-			glEventSystem* es = static_cast<glEventSystem*>(glfwGetWindowUserPointer(window));
-			
-			if(es != nullptr)
-				es->sendKbEvent(window, key, scancode, action, mods);
-		}
-
-		/// <summary>
-		///		Send the mouse movement event to the listeners
-		/// </summary>
-		void glEventSystem::sendMouseMovedEvent(GLFWwindow* window, int xpos, int ypos)
-		{
-			for (auto listener : MouseMovedListeners_) {
-				listener->receive(MouseMovedEvent{ 0, 0, MousePosition{xpos,ypos}});
-			}
-		}
-		
-
-		/// <summary>
-		///		GLFW mouse moved callback
-		/// </summary>
-		/// <param name="window">GLFW window that triggered the event</param>
-		/// <param name="xpos">New mouse X position</param>
-		/// <param name="ypos">New mouse Y position</param>
-		void glEventSystem::mouse_moved_callback(GLFWwindow* window, double xpos, double ypos)
-		{
-			// get back the pointer on this system stored by glfw (see constructor)
-			// to send the action to the listeners
-			glEventSystem* es = static_cast<glEventSystem*>(glfwGetWindowUserPointer(window));
-			
-			if(es != nullptr)
-				es->sendMouseMovedEvent(window, xpos, ypos);
-		}
-
-		/// <summary>
-		///		Send the mouse action event to the listeners
-		/// </summary>
-		void glEventSystem::sendMouseActionEvent(GLFWwindow* window, int button, int action, int mods)
-		{
-			double xpos, ypos;
-			glfwGetCursorPos(window, &xpos, &ypos);
-
-			for (auto listener : MouseActionListeners_) {
-				listener->receive(MouseActionEvent{ action, button, MousePosition{(int)xpos,(int)ypos} });
-			}
-		}
-
-		/// <summary>
-		///		GLFW mouse action callback
-		/// </summary>
-		/// <param name="window">Window that triggered the event</param>
-		/// <param name="button">Mouse button</param>
-		/// <param name="action">Press or release</param>
-		/// <param name="mods"></param>
-		void glEventSystem::mouse_action_callback(GLFWwindow* window, int button, int action, int mods)
-		{
-			// get back the pointer on this system stored by glfw (see constructor)
-			// to send the action to the listeners
-			glEventSystem* es = static_cast<glEventSystem*>(glfwGetWindowUserPointer(window));
-			
-			if(es != nullptr)
-				es->sendMouseActionEvent(window, button, action, mods);
-		}
-
-		/// <summary>
-		///     Window resized event callback
-		/// </summary>
-		/// <param name="wind"> The windows that has been resized </param>
-		/// <param name="width"> New width </param>
-		/// <param name="height"> New height </param>
-		void glEventSystem::window_resized_callback(GLFWwindow* window, int width, int height) {
-			// get back the pointer on this system stored by glfw (see constructor)
-			// to send the action to the listeners
-			glEventSystem* es = static_cast<glEventSystem*>(glfwGetWindowUserPointer(window));
-			
-			if(es != nullptr)
-				es->bindedWindow_->resize(width, height); // let the window deal with resizing !
-		}
-	}
-}
\ No newline at end of file
+#include <algorithm>
+#include <chrono>
+
+#include "headers/event_system.h"
+
+namespace ce {
+	namespace Event {
+
+		/// <summary>
+		///		Constructor. This event system may only be binded once to a window. Unbinded event system won't dispatch events. Use 1 event system by window.
+		/// </summary>
+		/// <param name="w">Window from which the event system will receive events</param>
+		glEventSystem::glEventSystem(ce::Graphic::ceWindow::ceRenderer* w)
+			: KeyBindings_( CE_KEY_COUNT ),
+			Dispatching_{ false },
+			Unbinded_{ false },
+			Queue_{ std::make_unique<EventQueue>() },
+			DroppedEvents_{ 0 },
+			Batch_{},
+			State_{},
+			Input_{ std::make_shared<const InputState>() },
+			Published_{ Input_ },
+			DispatchOnUpdate_{ true },
+			LastDispatch_{},
+			Source_{ nullptr },
+			Recorder_{ nullptr },
+			Bus_{ nullptr },
+			CoalesceMouse_{ true },
+			HasCursor_{ false },
+			Motion_{ 0.0, RawEventType::MOUSE_MOVED, 0, 0, 0, 0.0, 0.0, 0.0, 0.0 },
+			Renderer_{ w }
+		{
+			Batch_.reserve(CE_EVENT_QUEUE_SIZE);
+
+			// headless renderers have no window, events come from an EventSource
+			if (w && w->GetContextWindow() != nullptr)
+			{
+				auto const window = w->GetContextWindow();
+				// see if there is already an event system pointer for this window
+				auto es = static_cast<glEventSystem*>(glfwGetWindowUserPointer(window));
+
+				if (es == nullptr) { // just 1 event system by window !
+
+					// store a pointer on this event class into glfw
+					// to get it back into the callbacks
+					glfwSetWindowUserPointer(window, this);
+
+					glfwSetKeyCallback(window, kb_action_callback);
+					glfwSetCursorPosCallback(window, mouse_moved_callback);
+					glfwSetMouseButtonCallback(window, mouse_action_callback);
+					glfwSetWindowSizeCallback(window, window_resized_callback);
+
+					bindedWindow_ = w;
+					return;
+				}
+			}
+
+			bindedWindow_ = nullptr;
+		}
+
+		/// <summary>
+		///		Move constructor
+		/// </summary>
+		/// <param name="other">Event system to move</param>
+		glEventSystem::glEventSystem(glEventSystem&& other) noexcept
+		:	KeyboardListeners_{std::move(other.KeyboardListeners_)},
+			MouseMovedListeners_{std::move(other.MouseMovedListeners_)},
+			MouseActionListeners_{std::move(other.MouseActionListeners_)},
+			KeyBindings_{std::move(other.KeyBindings_)},
+			Dispatching_{false},
+			Unbinded_{other.Unbinded_},
+			Queue_{std::move(other.Queue_)},
+			DroppedEvents_{other.DroppedEvents_.load()},
+			Batch_{std::move(other.Batch_)},
+			State_{other.State_},
+			Input_{std::move(other.Input_)},
+			Published_{other.Published_.load()},
+			DispatchOnUpdate_{other.DispatchOnUpdate_},
+			LastDispatch_{other.LastDispatch_},
+			Source_{other.Source_},
+			Recorder_{other.Recorder_},
+			Bus_{other.Bus_},
+			CoalesceMouse_{other.CoalesceMouse_},
+			HasCursor_{other.HasCursor_},
+			Motion_{other.Motion_},
+			Renderer_{other.Renderer_},
+			bindedWindow_{other.bindedWindow_}
+		{
+			// the callbacks must find the new owner of the queue
+			if (bindedWindow_ != nullptr)
+				glfwSetWindowUserPointer(bindedWindow_->GetContextWindow(), this);
+
+			other.bindedWindow_ = nullptr;
+		}
+
+		/// <summary>
+		///		Move assignement
+		/// </summary>
+		/// <param name="other">Event system to move</param>
+		glEventSystem& glEventSystem::operator=(glEventSystem&& other) noexcept
+		{
+			KeyboardListeners_ = std::move(other.KeyboardListeners_);
+			MouseMovedListeners_ = std::move(other.MouseMovedListeners_);
+			MouseActionListeners_ = std::move(other.MouseActionListeners_);
+			KeyBindings_ = std::move(other.KeyBindings_);
+			Unbinded_ = other.Unbinded_;
+			Queue_ = std::move(other.Queue_);
+			DroppedEvents_ = other.DroppedEvents_.load();
+			Batch_ = std::move(other.Batch_);
+			State_ = other.State_;
+			Input_ = std::move(other.Input_);
+			Published_ = other.Published_.load();
+			DispatchOnUpdate_ = other.DispatchOnUpdate_;
+			LastDispatch_ = other.LastDispatch_;
+			Source_ = other.Source_;
+			Recorder_ = other.Recorder_;
+			Bus_ = other.Bus_;
+			CoalesceMouse_ = other.CoalesceMouse_;
+			HasCursor_ = other.HasCursor_;
+			Motion_ = other.Motion_;
+			Renderer_ = other.Renderer_;
+			bindedWindow_ = other.bindedWindow_;
+
+			if (bindedWindow_ != nullptr)
+				glfwSetWindowUserPointer(bindedWindow_->GetContextWindow(), this);
+
+			other.bindedWindow_ = nullptr;
+
+			return *this;
+		}
+
+		/// <summary>
+		///		Bind a keyboard listener to receive keyboard events
+		/// </summary>
+		/// <param name="listener">The listener to bind to this system</param>
+		void glEventSystem::bindKeyPressedListener(KbListener* listener)
+		{
+			if (listener != nullptr)
+				KeyboardListeners_.push_back(listener);
+		};
+
+		/// <summary>
+		///		Bind a mouse moved listener to receive mouse the new mouse position
+		/// </summary>
+		/// <param name="listener">The listener to bind to this system</param>
+		void glEventSystem::bindMouseMovedListener(MouseMovedListener* listener)
+		{
+			if (listener != nullptr)
+				MouseMovedListeners_.push_back(listener);
+		};
+
+		/// <summary>
+		///		Bind a mouse action listener to receive mouse button release/press and position
+		/// </summary>
+		/// <param name="listener">The listener to bind to this system</param>
+		void glEventSystem::bindMouseActionListener(MouseActionListener* listener)
+		{
+			if (listener != nullptr)
+				MouseActionListeners_.push_back(listener);
+		};
+
+		/// <summary>
+		///		Bind a keyboard listener to the events of a single key
+		/// </summary>
+		/// <param name="key">The key to listen to</param>
+		/// <param name="action">Pressed, released, hold or CE_ANY_ACTION</param>
+		/// <param name="listener">The listener to bind to this system</param>
+		/// <param name="mods">Exact GLFW modifier bits or CE_ANY_MODS</param>
+		void glEventSystem::bindKey(ceKbKeyType key, int action, KbListener* listener, int mods)
+		{
+			if (listener != nullptr && key >= 0 && static_cast<std::size_t>(key) < KeyBindings_.size())
+				KeyBindings_[key].push_back(KeyBinding{ listener, action, mods });
+		}
+
+		/// <summary>
+		///		Remove every binding of a listener to a key
+		/// </summary>
+		void glEventSystem::unbindKey(ceKbKeyType key, KbListener* listener)
+		{
+			if (key < 0 || static_cast<std::size_t>(key) >= KeyBindings_.size())
+				return;
+
+			for (auto& binding : KeyBindings_[key])
+				if (binding.listener == listener)
+				{
+					binding.listener = nullptr;
+					Unbinded_ = true;
+				}
+
+			compactListeners();
+		}
+
+		/// <summary>
+		///		Stop sending keyboard events to a listener binded with bindKeyPressedListener
+		/// </summary>
+		void glEventSystem::unbindKeyPressedListener(KbListener* listener)
+		{
+			for (auto& l : KeyboardListeners_)
+				if (l == listener)
+				{
+					l = nullptr;
+					Unbinded_ = true;
+				}
+
+			compactListeners();
+		}
+
+		/// <summary>
+		///		Stop sending mouse moved events to a listener
+		/// </summary>
+		void glEventSystem::unbindMouseMovedListener(MouseMovedListener* listener)
+		{
+			for (auto& l : MouseMovedListeners_)
+				if (l == listener)
+				{
+					l = nullptr;
+					Unbinded_ = true;
+				}
+
+			compactListeners();
+		}
+
+		/// <summary>
+		///		Stop sending mouse action events to a listener
+		/// </summary>
+		void glEventSystem::unbindMouseActionListener(MouseActionListener* listener)
+		{
+			for (auto& l : MouseActionListeners_)
+				if (l == listener)
+				{
+					l = nullptr;
+					Unbinded_ = true;
+				}
+
+			compactListeners();
+		}
+
+		/// <summary>
+		///		Remove the unbinded listeners, unless a dispatch is iterating over them
+		/// </summary>
+		void glEventSystem::compactListeners()
+		{
+			if (Dispatching_ || !Unbinded_)
+				return;
+
+			auto is_null = [](auto l) { return l == nullptr; };
+
+			KeyboardListeners_.erase(std::remove_if(KeyboardListeners_.begin(), KeyboardListeners_.end(), is_null), KeyboardListeners_.end());
+			MouseMovedListeners_.erase(std::remove_if(MouseMovedListeners_.begin(), MouseMovedListeners_.end(), is_null), MouseMovedListeners_.end());
+			MouseActionListeners_.erase(std::remove_if(MouseActionListeners_.begin(), MouseActionListeners_.end(), is_null), MouseActionListeners_.end());
+
+			for (auto& bindings : KeyBindings_)
+				bindings.erase(std::remove_if(bindings.begin(), bindings.end(), [](KeyBinding const& b) { return b.listener == nullptr; }), bindings.end());
+
+			Unbinded_ = false;
+		}
+
+
+		/// <summary>
+		///		Poll and send the events
+		/// </summary>
+		/// <param name="time_delta">Time elapsed since the last call for update control</param>
+		void glEventSystem::update(int time_delta)
+		{
+			// do not poll events if the system is not binded to window
+			// which happens when trying to bind 2 glEventSystem to a same window
+			if (Source_ != nullptr)
+				Source_->poll(*this);
+			else if (bindedWindow_ != nullptr)
+				glfwPollEvents();
+
+			// one mouse moved event by frame
+			queueMouseMotion();
+
+			if (DispatchOnUpdate_)
+				dispatch();
+		}
+
+		/// <summary>
+		///		Send the queued events to the listeners, grouped by type and in reception order inside a type.
+		///		Only one thread may dispatch at a time.
+		/// </summary>
+		void glEventSystem::dispatch()
+		{
+			auto const start = std::chrono::steady_clock::now();
+
+			Batch_.clear();
+
+			RawEvent event;
+			while (Queue_->pop(event))
+				Batch_.push_back(event);
+
+			if (Recorder_ != nullptr)
+				Recorder_->record(Batch_);
+
+			// the state sees the events in reception order
+			State_.beginFrame();
+
+			for (auto const& e : Batch_)
+				State_.apply(e);
+
+			Input_ = std::make_shared<const InputState>(State_);
+			Published_.store(Input_, std::memory_order_release);
+
+			// listeners may bind or unbind during the dispatch
+			Dispatching_ = true;
+
+			for (auto const& e : Batch_)
+				if (e.type == RawEventType::KEY)
+					sendKbEvent(e);
+
+			for (auto const& e : Batch_)
+				if (e.type == RawEventType::MOUSE_ACTION)
+					sendMouseActionEvent(e);
+
+			for (auto const& e : Batch_)
+				if (e.type == RawEventType::MOUSE_MOVED)
+					sendMouseMovedEvent(e);
+
+			// applied here and not in the callback : a replay resizes and redraws like the recorded run
+			if (Renderer_ != nullptr)
+				for (auto const& e : Batch_)
+					if (e.type == RawEventType::WINDOW_RESIZED)
+						Renderer_->resize(e.key, e.action);
+
+			// events raised by the worker threads, in one batch
+			if (Bus_ != nullptr)
+				Bus_->drainPosted();
+
+			Dispatching_ = false;
+			compactListeners();
+
+			auto const end = std::chrono::steady_clock::now();
+
+			LastDispatch_.dispatched = Batch_.size();
+			LastDispatch_.dropped = DroppedEvents_.exchange(0, std::memory_order_relaxed);
+			LastDispatch_.dispatch_ms = std::chrono::duration<double, std::milli>(end - start).count();
+		}
+
+		/// <summary>
+		///		Queue an event for the next dispatch
+		/// </summary>
+		void glEventSystem::queueEvent(RawEvent const& event)
+		{
+			if (!Queue_->push(event))
+				DroppedEvents_.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		/// <summary>
+		///		Queue the mouse samples merged since the last call
+		/// </summary>
+		void glEventSystem::queueMouseMotion()
+		{
+			if (Motion_.key == 0)
+				return;
+
+			queueEvent(Motion_);
+
+			Motion_.key = 0;
+			Motion_.dx = 0.0;
+			Motion_.dy = 0.0;
+		}
+
+		/// <summary>
+		///		Use the unscaled and unaccelerated mouse motion when the platform supports it.
+		///		Raw motion needs a disabled cursor, enabling it hides and captures the cursor.
+		/// </summary>
+		/// <param name="raw">Enable or disable raw motion</param>
+		/// <returns>True if the requested mode is active</returns>
+		bool glEventSystem::setRawMouseMotion(bool raw)
+		{
+			if (bindedWindow_ == nullptr)
+				return false;
+
+			auto const window = bindedWindow_->GetContextWindow();
+
+			if (raw && !glfwRawMouseMotionSupported())
+				return false;
+
+			glfwSetInputMode(window, GLFW_CURSOR, raw ? GLFW_CURSOR_DISABLED : GLFW_CURSOR_NORMAL);
+			glfwSetInputMode(window, GLFW_RAW_MOUSE_MOTION, raw ? GLFW_TRUE : GLFW_FALSE);
+
+			// the cursor jumps when the mode changes, do not count it as motion
+			HasCursor_ = false;
+
+			return true;
+		}
+
+		/// <summary>
+		///		Send the keyboard action to the listeners
+		/// </summary>
+		void glEventSystem::sendKbEvent(RawEvent const& event)
+		{
+			auto const kb = KbEvent{ event.action, event.key };
+
+			// index loops : a listener binded during the dispatch may grow the lists
+			for (std::size_t i = 0, n = KeyboardListeners_.size(); i < n; ++i) {
+				if (auto listener = KeyboardListeners_[i])
+					listener->receive(kb);
+			}
+
+			// only the listeners binded to this key
+			if (event.key < 0 || static_cast<std::size_t>(event.key) >= KeyBindings_.size())
+				return;
+
+			auto const& bindings = KeyBindings_[event.key];
+
+			for (std::size_t i = 0, n = bindings.size(); i < n; ++i) {
+				auto const binding = bindings[i];
+
+				if (binding.listener != nullptr &&
+					(binding.action == CE_ANY_ACTION || binding.action == event.action) &&
+					(binding.mods == CE_ANY_MODS || binding.mods == event.mods))
+					binding.listener->receive(kb);
+			}
+		}
+
+		/// <summary>
+		///		GLFW keyboard action callback
+		/// </summary>
+		void glEventSystem::kb_action_callback(GLFWwindow* window, int key, int scancode, int action, int mods)
+		{
+			// get back the pointer on this system stored by glfw (see constructor)
+			// to queue the action for the listeners
+			glEventSystem* es = static_cast<glEventSystem*>(glfwGetWindowUserPointer(window));
+
+			if(es != nullptr)
+				es->queueEvent(RawEvent{ glfwGetTime(), RawEventType::KEY, key, action, mods, 0.0, 0.0, 0.0, 0.0 });
+		}
+
+		/// <summary>
+		///		Send the mouse movement event to the listeners
+		/// </summary>
+		void glEventSystem::sendMouseMovedEvent(RawEvent const& event)
+		{
+			auto const moved = MouseMovedEvent{ CE_MOUSE_MOVED, event.x, event.y, event.dx, event.dy, event.key };
+
+			for (std::size_t i = 0, n = MouseMovedListeners_.size(); i < n; ++i) {
+				if (auto listener = MouseMovedListeners_[i])
+					listener->receive(moved);
+			}
+		}
+
+
+		/// <summary>
+		///		GLFW mouse moved callback
+		/// </summary>
+		/// <param name="window">GLFW window that triggered the event</param>
+		/// <param name="xpos">New mouse X position</param>
+		/// <param name="ypos">New mouse Y position</param>
+		void glEventSystem::mouse_moved_callback(GLFWwindow* window, double xpos, double ypos)
+		{
+			// get back the pointer on this system stored by glfw (see constructor)
+			// to queue the action for the listeners
+			glEventSystem* es = static_cast<glEventSystem*>(glfwGetWindowUserPointer(window));
+
+			if (es == nullptr)
+				return;
+
+			auto& motion = es->Motion_;
+
+			if (es->HasCursor_)
+			{
+				motion.dx += xpos - motion.x;
+				motion.dy += ypos - motion.y;
+			}
+
+			motion.time = glfwGetTime();
+			motion.action = CE_MOUSE_MOVED;
+			motion.x = xpos;
+			motion.y = ypos;
+			motion.key += 1;
+			es->HasCursor_ = true;
+
+			// high rate mode : every sample is an event
+			if (!es->CoalesceMouse_)
+				es->queueMouseMotion();
+		}
+
+		/// <summary>
+		///		Send the mouse action event to the listeners
+		/// </summary>
+		void glEventSystem::sendMouseActionEvent(RawEvent const& event)
+		{
+			auto const clicked = MouseActionEvent{ event.action, event.key, MousePosition{(int)event.x,(int)event.y} };
+
+			for (std::size_t i = 0, n = MouseActionListeners_.size(); i < n; ++i) {
+				if (auto listener = MouseActionListeners_[i])
+					listener->receive(clicked);
+			}
+		}
+
+		/// <summary>
+		///		GLFW mouse action callback
+		/// </summary>
+		/// <param name="window">Window that triggered the event</param>
+		/// <param name="button">Mouse button</param>
+		/// <param name="action">Press or release</param>
+		/// <param name="mods"></param>
+		void glEventSystem::mouse_action_callback(GLFWwindow* window, int button, int action, int mods)
+		{
+			// get back the pointer on this system stored by glfw (see constructor)
+			// to queue the action for the listeners
+			glEventSystem* es = static_cast<glEventSystem*>(glfwGetWindowUserPointer(window));
+
+			if (es != nullptr)
+			{
+				// position of the click, the cursor may have moved when the event is dispatched
+				double xpos, ypos;
+				glfwGetCursorPos(window, &xpos, &ypos);
+
+				es->queueEvent(RawEvent{ glfwGetTime(), RawEventType::MOUSE_ACTION, button, action, mods, xpos, ypos, 0.0, 0.0 });
+			}
+		}
+
+		/// <summary>
+		///     Window resized event callback
+		/// </summary>
+		/// <param name="wind"> The windows that has been resized </param>
+		/// <param name="width"> New width </param>
+		/// <param name="height"> New height </param>
+		void glEventSystem::window_resized_callback(GLFWwindow* window, int width, int height) {
+			// get back the pointer on this system stored by glfw (see constructor)
+			// to send the action to the listeners
+			glEventSystem* es = static_cast<glEventSystem*>(glfwGetWindowUserPointer(window));
+
+			// the window deals with the resize when the event is dispatched
+			if (es != nullptr)
+				es->queueEvent(RawEvent{ glfwGetTime(), RawEventType::WINDOW_RESIZED, width, height, 0, 0.0, 0.0, 0.0, 0.0 });
+		}
+	}
+}
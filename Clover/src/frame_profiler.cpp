@@ -0,0 +1,272 @@
+#include <cassert>
+#include <cstring>
+#include <utility>
+
+#include "headers/frame_profiler.h"
+#include "headers/glFunc.h"
+
+namespace ce {
+	namespace Graphic {
+
+		/// <summary>
+		///		Constructor. The queries are created by init, once a context exists.
+		/// </summary>
+		FrameProfiler::FrameProfiler()
+			: Slots_{},
+			Queries_{},
+			Current_{ 0 },
+			Open_{},
+			InFrame_{ false },
+			Dropped_{ 0 },
+			Mutex_{},
+			Published_{}
+		{}
+
+		/// <summary>
+		///		Destructor
+		/// </summary>
+		FrameProfiler::~FrameProfiler()
+		{
+			// the context may already be gone at shutdown, the queries went with it
+			if (!Queries_.empty() && GLFunc::IsReady())
+				glDeleteQueries(static_cast<GLsizei>(Queries_.size()), Queries_.data());
+		}
+
+		/// <summary>
+		///		Move constructor
+		/// </summary>
+		FrameProfiler::FrameProfiler(FrameProfiler&& other) noexcept
+			: Slots_{},
+			Queries_{ std::move(other.Queries_) },
+			Current_{ other.Current_ },
+			Open_{ std::move(other.Open_) },
+			InFrame_{ other.InFrame_ },
+			Dropped_{ other.Dropped_ },
+			Mutex_{},
+			Published_{ other.frame() }
+		{
+			for (std::size_t i = 0; i < CE_PROFILER_LATENCY; ++i)
+				Slots_[i] = std::move(other.Slots_[i]);
+
+			other.Queries_.clear();
+		}
+
+		/// <summary>
+		///		Move assignement
+		/// </summary>
+		FrameProfiler& FrameProfiler::operator=(FrameProfiler&& other) noexcept
+		{
+			if (this == &other)
+				return *this;
+
+			if (!Queries_.empty() && GLFunc::IsReady())
+				glDeleteQueries(static_cast<GLsizei>(Queries_.size()), Queries_.data());
+
+			for (std::size_t i = 0; i < CE_PROFILER_LATENCY; ++i)
+				Slots_[i] = std::move(other.Slots_[i]);
+
+			Queries_ = std::move(other.Queries_);
+			other.Queries_.clear();
+			Current_ = other.Current_;
+			Open_ = std::move(other.Open_);
+			InFrame_ = other.InFrame_;
+			Dropped_ = other.Dropped_;
+
+			auto published = other.frame();
+			std::lock_guard<std::mutex> lock{ Mutex_ };
+			Published_ = std::move(published);
+
+			return *this;
+		}
+
+		/// <summary>
+		///		Create the timestamp queries of every slot
+		/// </summary>
+		void FrameProfiler::init()
+		{
+			// a driver may expose the queries with a 0 bit counter : no GPU timing
+			GLint bits = 0;
+			glGetQueryiv(GL_TIMESTAMP, GL_QUERY_COUNTER_BITS, &bits);
+
+			if (bits == 0)
+				return;
+
+			Queries_.resize(CE_PROFILER_LATENCY * CE_PROFILER_MAX_ZONES * 2);
+			glGenQueries(static_cast<GLsizei>(Queries_.size()), Queries_.data());
+		}
+
+		/// <summary>
+		///		Read the frames done by the GPU, then start recording in the oldest slot
+		/// </summary>
+		void FrameProfiler::beginFrame()
+		{
+			if (InFrame_)
+				return;
+
+			// oldest first, the results are published in frame order
+			for (std::size_t i = 1; i <= CE_PROFILER_LATENCY; ++i)
+			{
+				auto const slot = (Current_ + i) % CE_PROFILER_LATENCY;
+				if (Slots_[slot].pending && available(slot))
+					collect(slot);
+			}
+
+			// the GPU is more than CE_PROFILER_LATENCY frames behind : waiting would stall the frame
+			auto& current = Slots_[Current_];
+			if (current.pending)
+			{
+				current.pending = false;
+				++Dropped_;
+			}
+
+			current.zones.clear();
+			InFrame_ = true;
+			begin("frame");
+		}
+
+		/// <summary>
+		///		Close the frame zone. The results come back a few frames later
+		/// </summary>
+		void FrameProfiler::endFrame()
+		{
+			if (!InFrame_)
+				return;
+
+			assert(Open_.size() == 1 && "A profile zone is still open at the end of the frame.");
+
+			while (!Open_.empty())
+				end();
+
+			auto& current = Slots_[Current_];
+
+			// CPU only : nothing to wait for
+			if (Queries_.empty())
+				publish(current, std::vector<double>(current.zones.size(), 0.0));
+			else
+				current.pending = true;
+
+			Current_ = (Current_ + 1) % CE_PROFILER_LATENCY;
+			InFrame_ = false;
+		}
+
+		/// <summary>
+		///		Open a zone, nested in the zones already open
+		/// </summary>
+		void FrameProfiler::begin(char const* name)
+		{
+			auto& zones = Slots_[Current_].zones;
+
+			if (!InFrame_ || zones.size() == CE_PROFILER_MAX_ZONES)
+			{
+				Open_.push_back(CE_PROFILER_MAX_ZONES);
+				return;
+			}
+
+			Open_.push_back(zones.size());
+			zones.push_back(ZoneRecord{ name, Clock::now(), 0.0 });
+
+			if (!Queries_.empty())
+				glQueryCounter(query(Current_, zones.size() - 1, false), GL_TIMESTAMP);
+		}
+
+		/// <summary>
+		///		Close the last zone opened
+		/// </summary>
+		void FrameProfiler::end()
+		{
+			assert(!Open_.empty() && "Profile zone ended without being opened.");
+
+			auto const zone = Open_.back();
+			Open_.pop_back();
+
+			if (zone == CE_PROFILER_MAX_ZONES)
+				return;
+
+			auto& record = Slots_[Current_].zones[zone];
+			record.cpu_ms = std::chrono::duration<double, std::milli>(Clock::now() - record.start).count();
+
+			if (!Queries_.empty())
+				glQueryCounter(query(Current_, zone, true), GL_TIMESTAMP);
+		}
+
+		/// <summary>
+		///		Zones of the last frame read back
+		/// </summary>
+		std::vector<ZoneTiming> FrameProfiler::frame() const
+		{
+			std::lock_guard<std::mutex> lock{ Mutex_ };
+			return Published_;
+		}
+
+		/// <summary>
+		///		The queries end in submission order : the last one being done, the frame is
+		/// </summary>
+		bool FrameProfiler::available(std::size_t slot) const
+		{
+			auto const& zones = Slots_[slot].zones;
+			if (zones.empty())
+				return true;
+
+			// the frame zone is ended last
+			GLint done = GL_FALSE;
+			glGetQueryObjectiv(query(slot, 0, true), GL_QUERY_RESULT_AVAILABLE, &done);
+			return done == GL_TRUE;
+		}
+
+		/// <summary>
+		///		Read the timestamps of a slot, they are available so this does not wait
+		/// </summary>
+		void FrameProfiler::collect(std::size_t slot)
+		{
+			auto& s = Slots_[slot];
+			std::vector<double> gpu_ms(s.zones.size(), 0.0);
+
+			for (std::size_t i = 0; i < s.zones.size(); ++i)
+			{
+				GLuint64 start = 0, end = 0;
+				glGetQueryObjectui64v(query(slot, i, false), GL_QUERY_RESULT, &start);
+				glGetQueryObjectui64v(query(slot, i, true), GL_QUERY_RESULT, &end);
+
+				// nanoseconds
+				gpu_ms[i] = end > start ? (end - start) / 1e6 : 0.0;
+			}
+
+			publish(s, gpu_ms);
+			s.pending = false;
+		}
+
+		/// <summary>
+		///		Sum the zones opened several times and make the frame visible to frame()
+		/// </summary>
+		void FrameProfiler::publish(Slot const& slot, std::vector<double> const& gpu_ms)
+		{
+			std::vector<ZoneTiming> timings;
+
+			for (std::size_t i = 0; i < slot.zones.size(); ++i)
+			{
+				auto const& zone = slot.zones[i];
+				auto it = timings.begin();
+
+				while (it != timings.end() && std::strcmp(it->name, zone.name) != 0)
+					++it;
+
+				if (it == timings.end())
+					timings.push_back(ZoneTiming{ zone.name, zone.cpu_ms, gpu_ms[i], 1 });
+				else
+				{
+					it->cpu_ms += zone.cpu_ms;
+					it->gpu_ms += gpu_ms[i];
+					++it->calls;
+				}
+			}
+
+			std::lock_guard<std::mutex> lock{ Mutex_ };
+			Published_ = std::move(timings);
+		}
+
+		GLuint FrameProfiler::query(std::size_t slot, std::size_t zone, bool end) const
+		{
+			return Queries_[(slot * CE_PROFILER_MAX_ZONES + zone) * 2 + (end ? 1 : 0)];
+		}
+	}
+}
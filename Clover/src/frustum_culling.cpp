@@ -0,0 +1,204 @@
+#include <cmath>
+
+#include "headers/frustum_culling.h"
+
+#if defined(CE_CULLING_AVX) || defined(CE_CULLING_SSE)
+#include <immintrin.h>
+#endif
+
+namespace ce {
+	namespace Graphic {
+
+		/// <summary>
+		///		Extract the frustum planes from the rows of a view projection matrix
+		/// </summary>
+		/// <param name="view_projection">Projection * view</param>
+		/// <returns>Planes with unit normals, distances are in world units</returns>
+		Frustum extract_frustum(glm::mat4 const& view_projection)
+		{
+			// glm is column major : row i is m[0][i], m[1][i], m[2][i], m[3][i]
+			auto row = [&view_projection](int i) {
+				return glm::vec4(view_projection[0][i], view_projection[1][i], view_projection[2][i], view_projection[3][i]);
+			};
+
+			glm::vec4 const rows[6] = {
+				row(3) + row(0), row(3) - row(0),	// left, right
+				row(3) + row(1), row(3) - row(1),	// bottom, top
+				row(3) + row(2), row(3) - row(2)	// near, far
+			};
+
+			Frustum frustum{};
+
+			for (int p = 0; p < 6; ++p)
+			{
+				auto const length = glm::length(glm::vec3(rows[p]));
+				auto const plane = length > 0.0f ? rows[p] / length : rows[p];
+				frustum.planes[p] = Plane{ plane.x, plane.y, plane.z, plane.w };
+			}
+
+			return frustum;
+		}
+
+		/// <summary>
+		///		Add a bounding volume
+		/// </summary>
+		/// <param name="center">World position of the volume</param>
+		/// <param name="radius">Sphere radius, zero for a box</param>
+		/// <param name="half_extents">Box half size, zero for a sphere</param>
+		void CullingSet::add(Core::fVec3 const& center, float radius, Core::fVec3 const& half_extents)
+		{
+			X_.push_back(center.x);
+			Y_.push_back(center.y);
+			Z_.push_back(center.z);
+			Radius_.push_back(radius);
+			ExtentX_.push_back(half_extents.x);
+			ExtentY_.push_back(half_extents.y);
+			ExtentZ_.push_back(half_extents.z);
+		}
+
+		void CullingSet::clear()
+		{
+			X_.clear();
+			Y_.clear();
+			Z_.clear();
+			Radius_.clear();
+			ExtentX_.clear();
+			ExtentY_.clear();
+			ExtentZ_.clear();
+		}
+
+		/// <summary>
+		///		Test every volume against the frustum, several at a time when SIMD is available
+		/// </summary>
+		/// <param name="frustum">Planes to test against</param>
+		/// <param name="visible">Receives the indices of the visible volumes, in increasing order</param>
+		void CullingSet::cull(Frustum const& frustum, std::vector<std::uint32_t>& visible) const
+		{
+			// the SIMD loop stops at the last full block, the remaining volumes are tested one by one
+			for (auto i = cull_simd(frustum, visible); i < size(); ++i)
+				if (inside(frustum, i))
+					visible.push_back(static_cast<std::uint32_t>(i));
+		}
+
+		/// <summary>
+		///		Scalar test of one volume : outside as soon as it is fully behind a plane
+		/// </summary>
+		bool CullingSet::inside(Frustum const& frustum, std::size_t i) const
+		{
+			for (auto const& p : frustum.planes)
+			{
+				auto const distance = p.a * X_[i] + p.b * Y_[i] + p.c * Z_[i] + p.d;
+				auto const reach = Radius_[i] + std::fabs(p.a) * ExtentX_[i] + std::fabs(p.b) * ExtentY_[i] + std::fabs(p.c) * ExtentZ_[i];
+
+				if (distance + reach < 0.0f)
+					return false;
+			}
+
+			return true;
+		}
+
+#if defined(CE_CULLING_AVX)
+
+		/// <summary>
+		///		Test 8 volumes per iteration
+		/// </summary>
+		/// <returns>Index of the first volume left untested</returns>
+		std::size_t CullingSet::cull_simd(Frustum const& frustum, std::vector<std::uint32_t>& visible) const
+		{
+			auto const zero = _mm256_setzero_ps();
+			auto const blocks = size() / 8 * 8;
+
+			for (std::size_t i = 0; i < blocks; i += 8)
+			{
+				auto const x = _mm256_loadu_ps(&X_[i]);
+				auto const y = _mm256_loadu_ps(&Y_[i]);
+				auto const z = _mm256_loadu_ps(&Z_[i]);
+				auto const radius = _mm256_loadu_ps(&Radius_[i]);
+				auto const ex = _mm256_loadu_ps(&ExtentX_[i]);
+				auto const ey = _mm256_loadu_ps(&ExtentY_[i]);
+				auto const ez = _mm256_loadu_ps(&ExtentZ_[i]);
+
+				auto in = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+
+				for (auto const& p : frustum.planes)
+				{
+					auto const distance = _mm256_add_ps(
+						_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(p.a), x), _mm256_mul_ps(_mm256_set1_ps(p.b), y)),
+						_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(p.c), z), _mm256_set1_ps(p.d)));
+
+					auto const reach = _mm256_add_ps(
+						_mm256_add_ps(radius, _mm256_mul_ps(_mm256_set1_ps(std::fabs(p.a)), ex)),
+						_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(std::fabs(p.b)), ey), _mm256_mul_ps(_mm256_set1_ps(std::fabs(p.c)), ez)));
+
+					in = _mm256_and_ps(in, _mm256_cmp_ps(_mm256_add_ps(distance, reach), zero, _CMP_GE_OQ));
+				}
+
+				auto const mask = _mm256_movemask_ps(in);
+
+				for (int lane = 0; lane < 8; ++lane)
+					if (mask & (1 << lane))
+						visible.push_back(static_cast<std::uint32_t>(i + lane));
+			}
+
+			return blocks;
+		}
+
+#elif defined(CE_CULLING_SSE)
+
+		/// <summary>
+		///		Test 4 volumes per iteration
+		/// </summary>
+		/// <returns>Index of the first volume left untested</returns>
+		std::size_t CullingSet::cull_simd(Frustum const& frustum, std::vector<std::uint32_t>& visible) const
+		{
+			auto const zero = _mm_setzero_ps();
+			auto const blocks = size() / 4 * 4;
+
+			for (std::size_t i = 0; i < blocks; i += 4)
+			{
+				auto const x = _mm_loadu_ps(&X_[i]);
+				auto const y = _mm_loadu_ps(&Y_[i]);
+				auto const z = _mm_loadu_ps(&Z_[i]);
+				auto const radius = _mm_loadu_ps(&Radius_[i]);
+				auto const ex = _mm_loadu_ps(&ExtentX_[i]);
+				auto const ey = _mm_loadu_ps(&ExtentY_[i]);
+				auto const ez = _mm_loadu_ps(&ExtentZ_[i]);
+
+				auto in = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+				for (auto const& p : frustum.planes)
+				{
+					auto const distance = _mm_add_ps(
+						_mm_add_ps(_mm_mul_ps(_mm_set1_ps(p.a), x), _mm_mul_ps(_mm_set1_ps(p.b), y)),
+						_mm_add_ps(_mm_mul_ps(_mm_set1_ps(p.c), z), _mm_set1_ps(p.d)));
+
+					auto const reach = _mm_add_ps(
+						_mm_add_ps(radius, _mm_mul_ps(_mm_set1_ps(std::fabs(p.a)), ex)),
+						_mm_add_ps(_mm_mul_ps(_mm_set1_ps(std::fabs(p.b)), ey), _mm_mul_ps(_mm_set1_ps(std::fabs(p.c)), ez)));
+
+					in = _mm_and_ps(in, _mm_cmpge_ps(_mm_add_ps(distance, reach), zero));
+				}
+
+				auto const mask = _mm_movemask_ps(in);
+
+				for (int lane = 0; lane < 4; ++lane)
+					if (mask & (1 << lane))
+						visible.push_back(static_cast<std::uint32_t>(i + lane));
+			}
+
+			return blocks;
+		}
+
+#else
+
+		/// <summary>
+		///		No SIMD : every volume goes through the scalar test
+		/// </summary>
+		std::size_t CullingSet::cull_simd(Frustum const&, std::vector<std::uint32_t>&) const
+		{
+			return 0;
+		}
+
+#endif
+	}
+}
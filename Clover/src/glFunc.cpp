@@ -1,420 +1,1143 @@
-#include <iostream>
-#include <assert.h>
-#include <fstream>
-#include <sstream>
-
-#include "headers/glFunc.h"
-
-//#define CE_VERBOSE
-
-namespace ce {
-    namespace Graphic {
-
-        // Initialization of the internal state
-        bool        GLFunc::InternalState::GLEW_INITIALIZED = false;
-        bool        GLFunc::InternalState::GLFW_INITIALIZED = false;
-        bool        GLFunc::InternalState::GLFUNC_READY = false;
-        GLuint      GLFunc::InternalState::SHADER_PROGRAM_ID = 0;
-        GLFWwindow* GLFunc::InternalState::CURRENT_CONTEXT_WINDOW = nullptr;
-        GLuint      GLFunc::InternalState::BINDED_VAO = 0;
-
-
-        void GLFunc::SetContextWindow(GLFWwindow* cw)
-        {
-            // avoid rebinding the same context
-            if (cw != nullptr && InternalState::CURRENT_CONTEXT_WINDOW != cw)
-            {
-                glfwMakeContextCurrent(cw);
-                InternalState::CURRENT_CONTEXT_WINDOW = cw;
-                glfwSwapInterval(1); // should it be here ? Works for now. 
-
-#ifdef CE_VERBOSE
-                std::cout << "Successfully set context window." << std::endl;
-#endif
-            }
-        }
-
-        GLFWwindow* GLFunc::CreateContextWindow(std::string title, int w, int h, bool set_current_context) {
-
-            if (!InternalState::GLFW_INITIALIZED)
-                init_glfw();
-
-            if (!InternalState::GLFW_INITIALIZED)
-            {
-                std::cerr << "Failed to initialize GLFW." << std::endl;
-                return nullptr;
-            }
-
-            GLFWwindow* win = CreateWindow(title, w, h);
-
-            if (win == nullptr)
-            {
-                std::cerr << "Failed to create the window." << std::endl;
-            }
-
-            if (set_current_context)
-                SetContextWindow(win);
-
-            if (!InternalState::GLEW_INITIALIZED)
-                init_glew();
-
-            if (!InternalState::GLEW_INITIALIZED)
-            {
-                std::cerr << "Failed to initialize glew." << std::endl;
-                TerminateGLFW();
-            }
-
-            InternalState::GLFUNC_READY = InternalState::GLEW_INITIALIZED &&
-                InternalState::GLFW_INITIALIZED &&
-                InternalState::CURRENT_CONTEXT_WINDOW != nullptr;
-
-            return win;
-        }
-
-        void GLFunc::BindVAO(GLuint vao_id) {
-            assert(InternalState::GLFUNC_READY && "GLFunc is not Ready. CreateContextWindow( ) must be called first.");
-
-            if (InternalState::BINDED_VAO != vao_id) {
-                glBindVertexArray(vao_id);
-                InternalState::BINDED_VAO = vao_id;
-#ifdef CE_VERBOSE
-                std::cout << "Binded VAO : " << vao_id << std::endl;
-#endif
-            }
-        }
-
-        void GLFunc::UnbindVao() {
-            assert(InternalState::GLFUNC_READY && "GLFunc is not Ready. CreateContextWindow( ) must be called first.");
-
-            BindVAO(0);
-        }
-
-        void GLFunc::EnableAttribute(int attrib) {
-            assert(InternalState::GLFUNC_READY && "GLFunc is not Ready. CreateContextWindow( ) must be called first.");
-
-
-            if (InternalState::BINDED_VAO != 0)
-            {
-                glEnableVertexAttribArray(attrib);
-#ifdef CE_VERBOSE
-                std::cout << "Enabled Attrib Array : " << attrib << std::endl;
-#endif
-            }
-        }
-
-        void GLFunc::DisableAttribute(int attrib) {
-            assert(InternalState::GLFUNC_READY && "GLFunc is not Ready. CreateContextWindow( ) must be called first.");
-
-            if (InternalState::BINDED_VAO != 0)
-            {
-                glDisableVertexAttribArray(attrib);
-#ifdef CE_VERBOSE
-                std::cout << "Disabled Attrib Array : " << attrib << std::endl;
-#endif
-            }
-        }
-
-        GLuint GLFunc::GetVAO() {
-            assert(InternalState::GLFUNC_READY && "GLFunc is not Ready. CreateContextWindow( ) must be called first.");
-
-            GLuint VertexArrayID;
-            glGenVertexArrays(1, &VertexArrayID);
-
-#ifdef CE_VERBOSE
-            std::cout << "Generated VAO id : " << VertexArrayID << std::endl;
-#endif
-
-            return VertexArrayID;
-        }
-
-        GLuint GLFunc::BindVBO(GLuint vao_id, vertices vertex_buffer, bool rebind_vao){
-            assert(InternalState::GLFUNC_READY && "GLFunc is not Ready. CreateContextWindow( ) must be called first.");
-
-#ifdef CE_VERBOSE
-            std::cout << "Binding a VBO to VAO id : " << vao_id << std::endl;
-#endif
-
-            GLuint vertexBufferID;
-            GLuint old_vao = 0;
-
-            if (!vao_is_binded(vao_id)) {
-
-#ifdef CE_VERBOSE
-                std::cout << "VAO was not binded , binding VAO id : " << vao_id << std::endl;
-#endif
-                if (InternalState::BINDED_VAO != 0)
-                {
-                    old_vao = InternalState::BINDED_VAO;
-                    GLFunc::UnbindVao();
-                    rebind_vao = true;
-                }
-                
-                GLFunc::BindVAO(vao_id);
-                
-            }
-
-            // generate , bind and fill the VBO
-            glGenBuffers(1, &vertexBufferID);
-            glBindBuffer(GL_ARRAY_BUFFER, vertexBufferID);
-            glBufferData(GL_ARRAY_BUFFER, vertex_buffer.size() * sizeof(GLfloat), vertex_buffer.data(), GL_STATIC_DRAW);
-
-            glVertexAttribPointer(
-                0,                  // attribute 0. No particular reason for 0, but must match the layout in the shader.
-                vertex_buffer.size() / 3,                  // size
-                GL_FLOAT,           // type
-                GL_FALSE,           // normalized?
-                0,                  // stride
-                (void*)0            // array buffer offset
-            );
-
-            if (rebind_vao)
-            {
-                GLFunc::UnbindVao();
-                GLFunc::BindVAO(old_vao);
-            }
-
-#ifdef CE_VERBOSE
-            std::cout << "Generated VBO ID : " << vertexBufferID << std::endl;
-#endif
-
-            return vertexBufferID;
-        }
-
-        GLFWwindow* GLFunc::CreateWindow(std::string title, int w, int h)
-        {
-
-            auto window = glfwCreateWindow(w, h, title.c_str(), nullptr, nullptr);
-
-            if (!window)
-            {
-                std::cerr << "Can not instantiate GLFW window." << std::endl;
-                return nullptr;
-            }
-
-#ifdef CE_VERBOSE
-            std::cout << "Created window titled [" << title << "] with size [" << w << " ," << h << std::endl;
-#endif
-
-            return window;
-        }
-
-        GLuint GLFunc::LoadShadersFromFiles(const char* vertex_file_path, const char* fragment_file_path) {
-            assert(InternalState::GLFUNC_READY && "GLFunc is not Ready. CreateContextWindow( ) must be called first.");
-
-            // Create the shaders
-            GLuint VertexShaderID = glCreateShader(GL_VERTEX_SHADER);
-            GLuint FragmentShaderID = glCreateShader(GL_FRAGMENT_SHADER);
-
-            // Read the Vertex Shader code from the file
-            std::string VertexShaderCode;
-            std::ifstream VertexShaderStream(vertex_file_path, std::ios::in);
-            if (VertexShaderStream.is_open()) {
-                std::stringstream sstr;
-                sstr << VertexShaderStream.rdbuf();
-                VertexShaderCode = sstr.str();
-                VertexShaderStream.close();
-            }
-            else {
-                printf("Impossible to open %s. Are you in the right directory ? Don't forget to read the FAQ !\n", vertex_file_path);
-                getchar();
-                return 0;
-            }
-
-            // Read the Fragment Shader code from the file
-            std::string FragmentShaderCode;
-            std::ifstream FragmentShaderStream(fragment_file_path, std::ios::in);
-            if (FragmentShaderStream.is_open()) {
-                std::stringstream sstr;
-                sstr << FragmentShaderStream.rdbuf();
-                FragmentShaderCode = sstr.str();
-                FragmentShaderStream.close();
-            }
-
-            return LoadStringShaders(VertexShaderCode, FragmentShaderCode);
-        }
-
-        GLuint GLFunc::LoadStringShaders(std::string VertexShaderCode, std::string FragmentShaderCode) {
-            assert(InternalState::GLFUNC_READY && "GLFunc is not Ready. CreateContextWindow( ) must be called first.");
-
-#ifdef CE_VERBOSE
-            std::cout << "Loading shaders" << std::endl;
-#endif
-
-            // Create the shaders
-            GLuint VertexShaderID = glCreateShader(GL_VERTEX_SHADER);
-            GLuint FragmentShaderID = glCreateShader(GL_FRAGMENT_SHADER);
-
-            GLint Result = GL_FALSE;
-            int InfoLogLength;
-
-            // Compile Vertex Shader
-            std::cout << "Compiling vertex shader." << std::endl;
-            char const* VertexSourcePointer = VertexShaderCode.c_str();
-            glShaderSource(VertexShaderID, 1, &VertexSourcePointer, NULL);
-            glCompileShader(VertexShaderID);
-
-            // Check Vertex Shader
-            glGetShaderiv(VertexShaderID, GL_COMPILE_STATUS, &Result);
-            glGetShaderiv(VertexShaderID, GL_INFO_LOG_LENGTH, &InfoLogLength);
-            if (InfoLogLength > 0) {
-                std::vector<char> VertexShaderErrorMessage(InfoLogLength + 1);
-                glGetShaderInfoLog(VertexShaderID, InfoLogLength, NULL, &VertexShaderErrorMessage[0]);
-                printf("%s\n", &VertexShaderErrorMessage[0]);
-            }
-
-            // Compile Fragment Shader
-            std::cout << "Compiling fragment shader." << std::endl;
-            char const* FragmentSourcePointer = FragmentShaderCode.c_str();
-            glShaderSource(FragmentShaderID, 1, &FragmentSourcePointer, NULL);
-            glCompileShader(FragmentShaderID);
-
-            // Check Fragment Shader
-            glGetShaderiv(FragmentShaderID, GL_COMPILE_STATUS, &Result);
-            glGetShaderiv(FragmentShaderID, GL_INFO_LOG_LENGTH, &InfoLogLength);
-            if (InfoLogLength > 0) {
-                std::vector<char> FragmentShaderErrorMessage(InfoLogLength + 1);
-                glGetShaderInfoLog(FragmentShaderID, InfoLogLength, NULL, &FragmentShaderErrorMessage[0]);
-                printf("%s\n", &FragmentShaderErrorMessage[0]);
-            }
-
-            // Link the program
-            std::cout << "Linking Program" << std::endl;
-            GLuint ProgramID = glCreateProgram();
-            glAttachShader(ProgramID, VertexShaderID);
-            glAttachShader(ProgramID, FragmentShaderID);
-            glLinkProgram(ProgramID);
-
-            // Check the program
-            glGetProgramiv(ProgramID, GL_LINK_STATUS, &Result);
-            glGetProgramiv(ProgramID, GL_INFO_LOG_LENGTH, &InfoLogLength);
-            if (InfoLogLength > 0) {
-                std::vector<char> ProgramErrorMessage(InfoLogLength + 1);
-                glGetProgramInfoLog(ProgramID, InfoLogLength, NULL, &ProgramErrorMessage[0]);
-                printf("%s\n", &ProgramErrorMessage[0]);
-            }
-
-            glDetachShader(ProgramID, VertexShaderID);
-            glDetachShader(ProgramID, FragmentShaderID);
-
-            glDeleteShader(VertexShaderID);
-            glDeleteShader(FragmentShaderID);
-
-            return ProgramID;
-        }
-
-        bool GLFunc::vao_is_binded(GLuint vao_id) {
-            return InternalState::BINDED_VAO == vao_id;
-        }
-
-        bool GLFunc::init_glew() {
-
-            if (InternalState::GLEW_INITIALIZED)
-                return true;
-
-#ifdef CE_VERBOSE
-            std::cout << "Initializing GLEW." << std::endl;
-#endif
-
-            glewExperimental = GL_TRUE;
-
-            GLenum error = glewInit();
-
-            if (error != GLEW_OK) {
-                std::cerr << "GLEW error : " << glewGetErrorString(error) << std::endl;
-                glfwTerminate();
-                return false;
-            }
-
-            InternalState::GLEW_INITIALIZED = true;
-
-#ifdef CE_VERBOSE
-            std::cout << "GLEW initializede successfully." << std::endl;
-#endif
-            return true;
-        }
-
-
-        bool GLFunc::init_glfw() {
-
-            if (InternalState::GLFW_INITIALIZED)
-                return true;
-
-
-#ifdef CE_VERBOSE
-            std::cout << "Initializing GLFW" << std::endl;
-#endif
-
-            glfwSetErrorCallback(show_glfw_error);
-
-            if (!glfwInit()) {
-                std::cerr << "GLFW init failed." << std::endl;
-                return false;
-            }
-
-            glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, CE_OPENGL_MAJOR);
-            glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, CE_OPENGL_MINOR);
-            glfwWindowHint(GLFW_OPENGL_PROFILE, CE_GLFW_OPENGL_PROFILE);
-            glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, CE_GLFW_OPENGL_FORWARD_COMPAT);
-
-            InternalState::GLFW_INITIALIZED = true;
-
-#ifdef CE_VERBOSE
-            std::cout << "GLFW initialized successfully." << std::endl;
-#endif
-            return true;
-        }
-
-        void GLFunc::show_glfw_error(int error, const char* description) {
-            std::cerr << "Error[" << error << "] :" << description << '\n';
-        }
-
-        void GLFunc::TerminateGLFW()
-        {
-            glfwTerminate();
-        }
-
-        void GLFunc::UseShader(GLuint program_id)
-        {
-            assert(InternalState::GLFUNC_READY && "GLFunc is not Ready. CreateContextWindow( ) must be called first.");
-
-            if (program_id != InternalState::SHADER_PROGRAM_ID)
-            {
-#ifdef CE_VERBOSE
-                std::cout << "Setting shader program id to : " << program_id << std::endl;
-#endif
-                glUseProgram(program_id);
-            }
-        }
-
-        GLuint GLFunc::GetShaderMatrixID(GLuint program_id, std::string matrix_name)
-        {
-            assert(InternalState::GLFUNC_READY && "GLFunc is not Ready. CreateContextWindow( ) must be called first.");
-            assert(program_id != 0 && "Shader program id is not valid.");
-               
-            return glGetUniformLocation(program_id, matrix_name.c_str());
-        }
-
-        void GLFunc::BindShaderMatrixData(GLuint matrix_id, float* data)
-        {
-            assert(InternalState::GLFUNC_READY && "GLFunc is not Ready. CreateContextWindow( ) must be called first.");
-            assert(matrix_id != -1 && "Shader matrix id is not valid.");
-
-            glUniformMatrix4fv(matrix_id, 1, GL_FALSE, data);
-        }
-
-        void GLFunc::DrawArrays(GLenum mode, GLint start, GLsizei count)
-        {
-            assert(InternalState::GLFUNC_READY && "GLFunc is not Ready. CreateContextWindow( ) must be called first.");
-            assert(InternalState::BINDED_VAO != 0 && "There is no binded vao.");
-
-            glDrawArrays(GL_TRIANGLES, start, count);
-        }
-
-        bool GLFunc::WindowShouldClose(GLFWwindow* w)
-        {
-            return w != nullptr ? glfwWindowShouldClose(w) : false;
-        }
-
-    }
-}
-
+#include <iostream>
+#include <assert.h>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#include "headers/glFunc.h"
+
+//#define CE_VERBOSE
+
+namespace ce {
+    namespace Graphic {
+
+        // Initialization of the internal state
+        bool        GLFunc::InternalState::GLEW_INITIALIZED = false;
+        bool        GLFunc::InternalState::GLFW_INITIALIZED = false;
+        bool        GLFunc::InternalState::GLFUNC_READY = false;
+        GLuint      GLFunc::InternalState::SHADER_PROGRAM_ID = 0;
+        GLFWwindow* GLFunc::InternalState::CURRENT_CONTEXT_WINDOW = nullptr;
+        GLuint      GLFunc::InternalState::BINDED_VAO = 0;
+        GLFWwindow* GLFunc::InternalState::CACHED_CONTEXT_WINDOW = nullptr;
+        std::unique_ptr<OffscreenContext> GLFunc::InternalState::OFFSCREEN_CONTEXT{};
+        bool        GLFunc::InternalState::OFFSCREEN_CURRENT = false;
+        GLuint      GLFunc::InternalState::BOUND_BUFFERS[CE_CACHED_BUFFER_TARGETS]{};
+        GLuint      GLFunc::InternalState::ACTIVE_TEXTURE_UNIT = 0;
+        GLuint      GLFunc::InternalState::BOUND_TEXTURES[CE_MAX_TEXTURE_UNITS][CE_CACHED_TEXTURE_TARGETS]{};
+        GLuint      GLFunc::InternalState::BOUND_SAMPLERS[CE_MAX_TEXTURE_UNITS]{};
+        GLuint      GLFunc::InternalState::READ_FRAMEBUFFER = 0;
+        GLuint      GLFunc::InternalState::DRAW_FRAMEBUFFER = 0;
+        GLFunc::RasterState GLFunc::InternalState::RASTER{};
+        std::map<GLuint, GLFunc::VertexArrayState> GLFunc::InternalState::VERTEX_ARRAYS{};
+        GLStateStats GLFunc::InternalState::STATE_STATS{};
+        std::map<GLuint, std::unique_ptr<ShaderProgram>> GLFunc::InternalState::PROGRAMS{};
+        ProgramCache* GLFunc::InternalState::PROGRAM_CACHE = nullptr;
+        std::map<GLFunc::ShaderRequest, GLFunc::ShaderRequestState> GLFunc::InternalState::SHADER_REQUESTS{};
+        GLFunc::ShaderRequest GLFunc::InternalState::NEXT_SHADER_REQUEST = 0;
+        std::size_t GLFunc::InternalState::SHADER_POLLS = 0;
+        bool        GLFunc::InternalState::PARALLEL_COMPILE = false;
+
+
+        void GLFunc::SetContextWindow(GLFWwindow* cw)
+        {
+            // avoid rebinding the same context
+            if (cw != nullptr && InternalState::CURRENT_CONTEXT_WINDOW != cw)
+            {
+                glfwMakeContextCurrent(cw);
+                InternalState::CURRENT_CONTEXT_WINDOW = cw;
+
+                // the cache describes one context, a context taken back after ReleaseContext kept its state
+                if (InternalState::CACHED_CONTEXT_WINDOW != cw)
+                {
+                    reset_state_cache();
+                    InternalState::CACHED_CONTEXT_WINDOW = cw;
+                }
+
+                glfwSwapInterval(1); // should it be here ? Works for now. 
+
+#ifdef CE_VERBOSE
+                std::cout << "Successfully set context window." << std::endl;
+#endif
+            }
+        }
+
+        void GLFunc::ReleaseContext()
+        {
+            if (InternalState::CURRENT_CONTEXT_WINDOW != nullptr)
+            {
+                glfwMakeContextCurrent(nullptr);
+                InternalState::CURRENT_CONTEXT_WINDOW = nullptr;
+
+#ifdef CE_VERBOSE
+                std::cout << "Released context window." << std::endl;
+#endif
+            }
+
+            if (InternalState::OFFSCREEN_CURRENT)
+            {
+                InternalState::OFFSCREEN_CONTEXT->release();
+                InternalState::OFFSCREEN_CURRENT = false;
+            }
+        }
+
+        void GLFunc::SetOffscreenContext()
+        {
+            if (InternalState::OFFSCREEN_CONTEXT && !InternalState::OFFSCREEN_CURRENT)
+            {
+                InternalState::OFFSCREEN_CURRENT = InternalState::OFFSCREEN_CONTEXT->makeCurrent();
+
+                // the offscreen context is described by the cache without window
+                if (InternalState::CACHED_CONTEXT_WINDOW != nullptr)
+                {
+                    reset_state_cache();
+                    InternalState::CACHED_CONTEXT_WINDOW = nullptr;
+                }
+            }
+        }
+
+        bool GLFunc::CreateOffscreenContext() {
+
+            if (!InternalState::OFFSCREEN_CONTEXT)
+            {
+                auto context = std::make_unique<OffscreenContext>();
+
+                if (!context->create(CE_OPENGL_MAJOR, CE_OPENGL_MINOR))
+                {
+                    std::cerr << "Failed to create the offscreen context." << std::endl;
+                    return false;
+                }
+
+                InternalState::OFFSCREEN_CONTEXT = std::move(context);
+            }
+
+            SetOffscreenContext();
+
+            // GLEW must be built with GLEW_EGL, its GLX loader fails without X server
+            if (!InternalState::GLEW_INITIALIZED)
+                init_glew();
+
+            if (!InternalState::GLEW_INITIALIZED)
+                std::cerr << "Failed to initialize glew." << std::endl;
+
+            InternalState::GLFUNC_READY = InternalState::GLEW_INITIALIZED &&
+                InternalState::OFFSCREEN_CURRENT;
+
+            return InternalState::GLFUNC_READY;
+        }
+
+        GLFWwindow* GLFunc::CreateContextWindow(std::string title, int w, int h, bool set_current_context) {
+
+            if (!InternalState::GLFW_INITIALIZED)
+                init_glfw();
+
+            if (!InternalState::GLFW_INITIALIZED)
+            {
+                std::cerr << "Failed to initialize GLFW." << std::endl;
+                return nullptr;
+            }
+
+            GLFWwindow* win = CreateWindow(title, w, h);
+
+            if (win == nullptr)
+            {
+                std::cerr << "Failed to create the window." << std::endl;
+            }
+
+            if (set_current_context)
+                SetContextWindow(win);
+
+            if (!InternalState::GLEW_INITIALIZED)
+                init_glew();
+
+            if (!InternalState::GLEW_INITIALIZED)
+            {
+                std::cerr << "Failed to initialize glew." << std::endl;
+                TerminateGLFW();
+            }
+
+            InternalState::GLFUNC_READY = InternalState::GLEW_INITIALIZED &&
+                InternalState::GLFW_INITIALIZED &&
+                InternalState::CURRENT_CONTEXT_WINDOW != nullptr;
+
+            return win;
+        }
+
+        void GLFunc::BindVAO(GLuint vao_id) {
+            assert(InternalState::GLFUNC_READY && "GLFunc is not Ready. CreateContextWindow( ) must be called first.");
+
+            if (!skip_call(InternalState::BINDED_VAO == vao_id)) {
+                glBindVertexArray(vao_id);
+                InternalState::BINDED_VAO = vao_id;
+#ifdef CE_VERBOSE
+                std::cout << "Binded VAO : " << vao_id << std::endl;
+#endif
+            }
+        }
+
+        void GLFunc::UnbindVao() {
+            assert(InternalState::GLFUNC_READY && "GLFunc is not Ready. CreateContextWindow( ) must be called first.");
+
+            BindVAO(0);
+        }
+
+        void GLFunc::EnableAttribute(int attrib) {
+            assert(InternalState::GLFUNC_READY && "GLFunc is not Ready. CreateContextWindow( ) must be called first.");
+
+
+            if (InternalState::BINDED_VAO != 0)
+            {
+                auto& vao = InternalState::VERTEX_ARRAYS[InternalState::BINDED_VAO];
+                auto const bit = attrib < CE_CACHED_VERTEX_ATTRIBUTES ? std::uint32_t{ 1 } << attrib : 0;
+
+                if (skip_call(bit != 0 && (vao.enabled_attributes & bit) != 0))
+                    return;
+
+                vao.enabled_attributes |= bit;
+                glEnableVertexAttribArray(attrib);
+#ifdef CE_VERBOSE
+                std::cout << "Enabled Attrib Array : " << attrib << std::endl;
+#endif
+            }
+        }
+
+        void GLFunc::DisableAttribute(int attrib) {
+            assert(InternalState::GLFUNC_READY && "GLFunc is not Ready. CreateContextWindow( ) must be called first.");
+
+            if (InternalState::BINDED_VAO != 0)
+            {
+                auto& vao = InternalState::VERTEX_ARRAYS[InternalState::BINDED_VAO];
+                auto const bit = attrib < CE_CACHED_VERTEX_ATTRIBUTES ? std::uint32_t{ 1 } << attrib : 0;
+
+                if (skip_call(bit != 0 && (vao.enabled_attributes & bit) == 0))
+                    return;
+
+                vao.enabled_attributes &= ~bit;
+                glDisableVertexAttribArray(attrib);
+#ifdef CE_VERBOSE
+                std::cout << "Disabled Attrib Array : " << attrib << std::endl;
+#endif
+            }
+        }
+
+        GLuint GLFunc::GetVAO() {
+            assert(InternalState::GLFUNC_READY && "GLFunc is not Ready. CreateContextWindow( ) must be called first.");
+
+            GLuint VertexArrayID;
+            glGenVertexArrays(1, &VertexArrayID);
+
+#ifdef CE_VERBOSE
+            std::cout << "Generated VAO id : " << VertexArrayID << std::endl;
+#endif
+
+            return VertexArrayID;
+        }
+
+        void GLFunc::DeleteVAO(GLuint vao_id) {
+            assert(InternalState::GLFUNC_READY && "GLFunc is not Ready. CreateContextWindow( ) must be called first.");
+
+            if (InternalState::BINDED_VAO == vao_id)
+                UnbindVao();
+
+            InternalState::VERTEX_ARRAYS.erase(vao_id);
+            glDeleteVertexArrays(1, &vao_id);
+        }
+
+        GLuint GLFunc::BindVBO(GLuint vao_id, vertices vertex_buffer, bool rebind_vao){
+            assert(InternalState::GLFUNC_READY && "GLFunc is not Ready. CreateContextWindow( ) must be called first.");
+
+#ifdef CE_VERBOSE
+            std::cout << "Binding a VBO to VAO id : " << vao_id << std::endl;
+#endif
+
+            GLuint vertexBufferID;
+            GLuint old_vao = 0;
+
+            if (!vao_is_binded(vao_id)) {
+
+#ifdef CE_VERBOSE
+                std::cout << "VAO was not binded , binding VAO id : " << vao_id << std::endl;
+#endif
+                if (InternalState::BINDED_VAO != 0)
+                {
+                    old_vao = InternalState::BINDED_VAO;
+                    GLFunc::UnbindVao();
+                    rebind_vao = true;
+                }
+                
+                GLFunc::BindVAO(vao_id);
+                
+            }
+
+            // generate , bind and fill the VBO
+            glGenBuffers(1, &vertexBufferID);
+            GLFunc::BindBuffer(GL_ARRAY_BUFFER, vertexBufferID);
+            glBufferData(GL_ARRAY_BUFFER, vertex_buffer.size() * sizeof(GLfloat), vertex_buffer.data(), GL_STATIC_DRAW);
+
+            glVertexAttribPointer(
+                0,                  // attribute 0. No particular reason for 0, but must match the layout in the shader.
+                3,                  // size : x, y, z
+                GL_FLOAT,           // type
+                GL_FALSE,           // normalized?
+                0,                  // stride
+                (void*)0            // array buffer offset
+            );
+
+            if (rebind_vao)
+            {
+                GLFunc::UnbindVao();
+                GLFunc::BindVAO(old_vao);
+            }
+
+#ifdef CE_VERBOSE
+            std::cout << "Generated VBO ID : " << vertexBufferID << std::endl;
+#endif
+
+            return vertexBufferID;
+        }
+
+        GLuint GLFunc::GenBuffer() {
+            assert(InternalState::GLFUNC_READY && "GLFunc is not Ready. CreateContextWindow( ) must be called first.");
+
+            GLuint buffer_id;
+            glGenBuffers(1, &buffer_id);
+
+#ifdef CE_VERBOSE
+            std::cout << "Generated buffer id : " << buffer_id << std::endl;
+#endif
+
+            return buffer_id;
+        }
+
+        void GLFunc::DeleteBuffer(GLuint buffer_id) {
+            assert(InternalState::GLFUNC_READY && "GLFunc is not Ready. CreateContextWindow( ) must be called first.");
+
+            // GL unbinds a deleted buffer, the name may come back from GenBuffer
+            for (auto& bound : InternalState::BOUND_BUFFERS)
+                if (bound == buffer_id)
+                    bound = 0;
+
+            for (auto& [vao_id, vao] : InternalState::VERTEX_ARRAYS)
+                if (vao.element_buffer == buffer_id)
+                    vao.element_buffer = 0;
+
+            glDeleteBuffers(1, &buffer_id);
+        }
+
+        void GLFunc::BindBuffer(GLenum target, GLuint buffer_id) {
+            assert(InternalState::GLFUNC_READY && "GLFunc is not Ready. CreateContextWindow( ) must be called first.");
+
+            GLuint* bound = nullptr;
+
+            // the element array binding is part of the VAO state
+            if (target == GL_ELEMENT_ARRAY_BUFFER)
+                bound = &InternalState::VERTEX_ARRAYS[InternalState::BINDED_VAO].element_buffer;
+            else if (auto const slot = buffer_slot(target); slot >= 0)
+                bound = &InternalState::BOUND_BUFFERS[slot];
+
+            if (skip_call(bound != nullptr && *bound == buffer_id))
+                return;
+
+            if (bound != nullptr)
+                *bound = buffer_id;
+
+            glBindBuffer(target, buffer_id);
+        }
+
+        void GLFunc::BufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage) {
+            assert(InternalState::GLFUNC_READY && "GLFunc is not Ready. CreateContextWindow( ) must be called first.");
+
+            glBufferData(target, size, data, usage);
+        }
+
+        void GLFunc::BufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data) {
+            assert(InternalState::GLFUNC_READY && "GLFunc is not Ready. CreateContextWindow( ) must be called first.");
+
+            glBufferSubData(target, offset, size, data);
+        }
+
+        void GLFunc::VertexAttribPointer(GLuint attrib, GLint size, GLenum type, GLsizei stride, GLintptr offset) {
+            assert(InternalState::GLFUNC_READY && "GLFunc is not Ready. CreateContextWindow( ) must be called first.");
+            assert(InternalState::BINDED_VAO != 0 && "There is no binded vao.");
+
+            glVertexAttribPointer(attrib, size, type, GL_FALSE, stride, reinterpret_cast<void*>(offset));
+        }
+
+        void GLFunc::VertexAttribDivisor(GLuint attrib, GLuint divisor) {
+            assert(InternalState::GLFUNC_READY && "GLFunc is not Ready. CreateContextWindow( ) must be called first.");
+            assert(InternalState::BINDED_VAO != 0 && "There is no binded vao.");
+
+            glVertexAttribDivisor(attrib, divisor);
+        }
+
+        GLuint GLFunc::GenTexture() {
+            assert(InternalState::GLFUNC_READY && "GLFunc is not Ready. CreateContextWindow( ) must be called first.");
+
+            GLuint texture_id;
+            glGenTextures(1, &texture_id);
+
+            return texture_id;
+        }
+
+        void GLFunc::DeleteTexture(GLuint texture_id) {
+            assert(InternalState::GLFUNC_READY && "GLFunc is not Ready. CreateContextWindow( ) must be called first.");
+
+            for (auto& unit : InternalState::BOUND_TEXTURES)
+                for (auto& bound : unit)
+                    if (bound == texture_id)
+                        bound = 0;
+
+            glDeleteTextures(1, &texture_id);
+        }
+
+        void GLFunc::ActiveTexture(GLuint unit) {
+            assert(InternalState::GLFUNC_READY && "GLFunc is not Ready. CreateContextWindow( ) must be called first.");
+
+            if (skip_call(InternalState::ACTIVE_TEXTURE_UNIT == unit))
+                return;
+
+            InternalState::ACTIVE_TEXTURE_UNIT = unit;
+            glActiveTexture(GL_TEXTURE0 + unit);
+        }
+
+        void GLFunc::BindTexture(GLuint unit, GLenum target, GLuint texture_id) {
+            assert(InternalState::GLFUNC_READY && "GLFunc is not Ready. CreateContextWindow( ) must be called first.");
+
+            auto const slot = texture_slot(target);
+            auto const cached = unit < CE_MAX_TEXTURE_UNITS && slot >= 0;
+
+            // the unit only has to be made active when the binding changes
+            if (skip_call(cached && InternalState::BOUND_TEXTURES[unit][slot] == texture_id))
+                return;
+
+            if (cached)
+                InternalState::BOUND_TEXTURES[unit][slot] = texture_id;
+
+            ActiveTexture(unit);
+            glBindTexture(target, texture_id);
+        }
+
+        void GLFunc::BindSampler(GLuint unit, GLuint sampler_id) {
+            assert(InternalState::GLFUNC_READY && "GLFunc is not Ready. CreateContextWindow( ) must be called first.");
+
+            auto const cached = unit < CE_MAX_TEXTURE_UNITS;
+
+            if (skip_call(cached && InternalState::BOUND_SAMPLERS[unit] == sampler_id))
+                return;
+
+            if (cached)
+                InternalState::BOUND_SAMPLERS[unit] = sampler_id;
+
+            glBindSampler(unit, sampler_id);
+        }
+
+        GLuint GLFunc::GenFramebuffer() {
+            assert(InternalState::GLFUNC_READY && "GLFunc is not Ready. CreateContextWindow( ) must be called first.");
+
+            GLuint framebuffer_id;
+            glGenFramebuffers(1, &framebuffer_id);
+
+            return framebuffer_id;
+        }
+
+        void GLFunc::DeleteFramebuffer(GLuint framebuffer_id) {
+            assert(InternalState::GLFUNC_READY && "GLFunc is not Ready. CreateContextWindow( ) must be called first.");
+
+            // deleting a bound framebuffer binds the default one back
+            if (InternalState::READ_FRAMEBUFFER == framebuffer_id)
+                InternalState::READ_FRAMEBUFFER = 0;
+
+            if (InternalState::DRAW_FRAMEBUFFER == framebuffer_id)
+                InternalState::DRAW_FRAMEBUFFER = 0;
+
+            glDeleteFramebuffers(1, &framebuffer_id);
+        }
+
+        void GLFunc::BindFramebuffer(GLenum target, GLuint framebuffer_id) {
+            assert(InternalState::GLFUNC_READY && "GLFunc is not Ready. CreateContextWindow( ) must be called first.");
+
+            auto const read = target == GL_FRAMEBUFFER || target == GL_READ_FRAMEBUFFER;
+            auto const draw = target == GL_FRAMEBUFFER || target == GL_DRAW_FRAMEBUFFER;
+
+            if (skip_call((!read || InternalState::READ_FRAMEBUFFER == framebuffer_id) &&
+                (!draw || InternalState::DRAW_FRAMEBUFFER == framebuffer_id)))
+                return;
+
+            if (read)
+                InternalState::READ_FRAMEBUFFER = framebuffer_id;
+
+            if (draw)
+                InternalState::DRAW_FRAMEBUFFER = framebuffer_id;
+
+            glBindFramebuffer(target, framebuffer_id);
+        }
+
+        void GLFunc::SetCapability(GLenum capability, bool enabled) {
+            assert(InternalState::GLFUNC_READY && "GLFunc is not Ready. CreateContextWindow( ) must be called first.");
+
+            auto const slot = capability_slot(capability);
+
+            if (skip_call(slot >= 0 && InternalState::RASTER.capabilities[slot] == enabled))
+                return;
+
+            if (slot >= 0)
+                InternalState::RASTER.capabilities[slot] = enabled;
+
+            if (enabled)
+                glEnable(capability);
+            else
+                glDisable(capability);
+        }
+
+        void GLFunc::BlendFunc(GLenum source, GLenum destination) {
+            assert(InternalState::GLFUNC_READY && "GLFunc is not Ready. CreateContextWindow( ) must be called first.");
+
+            auto& raster = InternalState::RASTER;
+
+            if (skip_call(raster.blend_source == source && raster.blend_destination == destination))
+                return;
+
+            raster.blend_source = source;
+            raster.blend_destination = destination;
+            glBlendFunc(source, destination);
+        }
+
+        void GLFunc::DepthFunc(GLenum func) {
+            assert(InternalState::GLFUNC_READY && "GLFunc is not Ready. CreateContextWindow( ) must be called first.");
+
+            if (skip_call(InternalState::RASTER.depth_func == func))
+                return;
+
+            InternalState::RASTER.depth_func = func;
+            glDepthFunc(func);
+        }
+
+        void GLFunc::DepthMask(bool write) {
+            assert(InternalState::GLFUNC_READY && "GLFunc is not Ready. CreateContextWindow( ) must be called first.");
+
+            if (skip_call(InternalState::RASTER.depth_mask == write))
+                return;
+
+            InternalState::RASTER.depth_mask = write;
+            glDepthMask(write ? GL_TRUE : GL_FALSE);
+        }
+
+        void GLFunc::CullFace(GLenum face) {
+            assert(InternalState::GLFUNC_READY && "GLFunc is not Ready. CreateContextWindow( ) must be called first.");
+
+            if (skip_call(InternalState::RASTER.cull_face == face))
+                return;
+
+            InternalState::RASTER.cull_face = face;
+            glCullFace(face);
+        }
+
+        void GLFunc::Scissor(GLint x, GLint y, GLsizei width, GLsizei height) {
+            assert(InternalState::GLFUNC_READY && "GLFunc is not Ready. CreateContextWindow( ) must be called first.");
+
+            auto& box = InternalState::RASTER.scissor;
+
+            if (skip_call(box[0] == x && box[1] == y && box[2] == width && box[3] == height))
+                return;
+
+            box[0] = x; box[1] = y; box[2] = width; box[3] = height;
+            glScissor(x, y, width, height);
+        }
+
+        void GLFunc::Viewport(GLint x, GLint y, GLsizei width, GLsizei height) {
+            assert(InternalState::GLFUNC_READY && "GLFunc is not Ready. CreateContextWindow( ) must be called first.");
+
+            auto& box = InternalState::RASTER.viewport;
+
+            if (skip_call(box[0] == x && box[1] == y && box[2] == width && box[3] == height))
+                return;
+
+            box[0] = x; box[1] = y; box[2] = width; box[3] = height;
+            glViewport(x, y, width, height);
+        }
+
+        void GLFunc::ClearColor(GLfloat r, GLfloat g, GLfloat b, GLfloat a) {
+            assert(InternalState::GLFUNC_READY && "GLFunc is not Ready. CreateContextWindow( ) must be called first.");
+
+            auto& c = InternalState::RASTER.clear_color;
+
+            if (skip_call(c[0] == r && c[1] == g && c[2] == b && c[3] == a))
+                return;
+
+            c[0] = r; c[1] = g; c[2] = b; c[3] = a;
+            glClearColor(r, g, b, a);
+        }
+
+        GLFWwindow* GLFunc::CreateWindow(std::string title, int w, int h)
+        {
+
+            auto window = glfwCreateWindow(w, h, title.c_str(), nullptr, nullptr);
+
+            if (!window)
+            {
+                std::cerr << "Can not instantiate GLFW window." << std::endl;
+                return nullptr;
+            }
+
+#ifdef CE_VERBOSE
+            std::cout << "Created window titled [" << title << "] with size [" << w << " ," << h << std::endl;
+#endif
+
+            return window;
+        }
+
+        GLuint GLFunc::LoadShadersFromFiles(const char* vertex_file_path, const char* fragment_file_path) {
+            assert(InternalState::GLFUNC_READY && "GLFunc is not Ready. CreateContextWindow( ) must be called first.");
+
+            // Create the shaders
+            GLuint VertexShaderID = glCreateShader(GL_VERTEX_SHADER);
+            GLuint FragmentShaderID = glCreateShader(GL_FRAGMENT_SHADER);
+
+            // Read the Vertex Shader code from the file
+            std::string VertexShaderCode;
+            std::ifstream VertexShaderStream(vertex_file_path, std::ios::in);
+            if (VertexShaderStream.is_open()) {
+                std::stringstream sstr;
+                sstr << VertexShaderStream.rdbuf();
+                VertexShaderCode = sstr.str();
+                VertexShaderStream.close();
+            }
+            else {
+                printf("Impossible to open %s. Are you in the right directory ? Don't forget to read the FAQ !\n", vertex_file_path);
+                getchar();
+                return 0;
+            }
+
+            // Read the Fragment Shader code from the file
+            std::string FragmentShaderCode;
+            std::ifstream FragmentShaderStream(fragment_file_path, std::ios::in);
+            if (FragmentShaderStream.is_open()) {
+                std::stringstream sstr;
+                sstr << FragmentShaderStream.rdbuf();
+                FragmentShaderCode = sstr.str();
+                FragmentShaderStream.close();
+            }
+
+            return LoadStringShaders(VertexShaderCode, FragmentShaderCode);
+        }
+
+        GLuint GLFunc::LoadStringShaders(std::string VertexShaderCode, std::string FragmentShaderCode, std::string const& Defines) {
+            assert(InternalState::GLFUNC_READY && "GLFunc is not Ready. CreateContextWindow( ) must be called first.");
+
+#ifdef CE_VERBOSE
+            std::cout << "Loading shaders" << std::endl;
+#endif
+
+            auto build = begin_program(inject_defines(VertexShaderCode, Defines), inject_defines(FragmentShaderCode, Defines));
+
+            // programs from the cache are already linked
+            if (build.vertex != 0)
+                end_program(build);
+
+            return build.program;
+        }
+
+        GLFunc::ShaderRequest GLFunc::CompileShadersAsync(std::string VertexShaderCode, std::string FragmentShaderCode, std::string const& Defines)
+        {
+            assert(InternalState::GLFUNC_READY && "GLFunc is not Ready. CreateContextWindow( ) must be called first.");
+
+            auto build = begin_program(inject_defines(VertexShaderCode, Defines), inject_defines(FragmentShaderCode, Defines));
+            auto const status = build.vertex == 0 ? ShaderStatus::READY : ShaderStatus::PENDING;
+
+            auto const request = InternalState::NEXT_SHADER_REQUEST++;
+            InternalState::SHADER_REQUESTS.emplace(request, ShaderRequestState{ build, status, InternalState::SHADER_POLLS });
+            return request;
+        }
+
+        void GLFunc::PollShaders()
+        {
+            assert(InternalState::GLFUNC_READY && "GLFunc is not Ready. CreateContextWindow( ) must be called first.");
+
+            ++InternalState::SHADER_POLLS;
+
+            for (auto& [id, request] : InternalState::SHADER_REQUESTS)
+            {
+                if (request.status != ShaderStatus::PENDING)
+                    continue;
+
+                bool done;
+
+                if (InternalState::PARALLEL_COMPILE)
+                {
+                    // asking for the completion never waits
+                    GLint completed = GL_FALSE;
+                    glGetProgramiv(request.build.program, GL_COMPLETION_STATUS_KHR, &completed);
+                    done = completed == GL_TRUE;
+                }
+                else
+                {
+                    // no way to know : give the driver a whole frame before the status query, which may block
+                    done = request.poll + 1 < InternalState::SHADER_POLLS;
+                }
+
+                if (done)
+                    finish_request(request);
+            }
+        }
+
+        void GLFunc::FinishShaders()
+        {
+            assert(InternalState::GLFUNC_READY && "GLFunc is not Ready. CreateContextWindow( ) must be called first.");
+
+            for (auto& [id, request] : InternalState::SHADER_REQUESTS)
+                if (request.status == ShaderStatus::PENDING)
+                    finish_request(request);
+        }
+
+        GLFunc::ShaderStatus GLFunc::GetShaderStatus(ShaderRequest request)
+        {
+            auto const found = InternalState::SHADER_REQUESTS.find(request);
+            assert(found != InternalState::SHADER_REQUESTS.end() && "Invalid or already handed over shader request.");
+
+            return found->second.status;
+        }
+
+        GLuint GLFunc::GetRequestProgram(ShaderRequest request, GLuint fallback)
+        {
+            auto const found = InternalState::SHADER_REQUESTS.find(request);
+
+            if (found == InternalState::SHADER_REQUESTS.end())
+                return fallback;
+
+            auto const status = found->second.status;
+            auto const program = found->second.build.program;
+
+            if (status == ShaderStatus::PENDING)
+                return fallback;
+
+            // done : the caller keeps the program, or the fallback of a failed request
+            InternalState::SHADER_REQUESTS.erase(found);
+            return status == ShaderStatus::READY ? program : fallback;
+        }
+
+        GLuint GLFunc::GetRequestProgramName(ShaderRequest request)
+        {
+            auto const found = InternalState::SHADER_REQUESTS.find(request);
+            assert(found != InternalState::SHADER_REQUESTS.end() && "Invalid or already handed over shader request.");
+
+            return found->second.build.program;
+        }
+
+        void GLFunc::finish_request(ShaderRequestState& request)
+        {
+            if (end_program(request.build))
+            {
+                request.status = ShaderStatus::READY;
+                return;
+            }
+
+            // nothing will ever draw with it
+            request.status = ShaderStatus::FAILED;
+            DeleteProgram(request.build.program);
+        }
+
+        GLFunc::ProgramBuild GLFunc::begin_program(std::string const& VertexShaderCode, std::string const& FragmentShaderCode)
+        {
+            // a linked binary of the same sources on the same driver skips the compilation
+            auto const cached = InternalState::PROGRAM_CACHE != nullptr && GLEW_ARB_get_program_binary;
+            std::uint64_t key = 0;
+
+            if (cached)
+            {
+                key = program_key(VertexShaderCode, FragmentShaderCode);
+
+                if (auto const program_id = load_program_binary(key); program_id != 0)
+                    return ProgramBuild{ program_id, 0, 0, key, true };
+            }
+
+            // Create the shaders
+            GLuint VertexShaderID = glCreateShader(GL_VERTEX_SHADER);
+            GLuint FragmentShaderID = glCreateShader(GL_FRAGMENT_SHADER);
+
+            // Compile the shaders, their status is only asked by end_program : the driver may compile in the background
+#ifdef CE_VERBOSE
+            std::cout << "Compiling vertex and fragment shaders." << std::endl;
+#endif
+            char const* VertexSourcePointer = VertexShaderCode.c_str();
+            glShaderSource(VertexShaderID, 1, &VertexSourcePointer, NULL);
+            glCompileShader(VertexShaderID);
+
+            char const* FragmentSourcePointer = FragmentShaderCode.c_str();
+            glShaderSource(FragmentShaderID, 1, &FragmentSourcePointer, NULL);
+            glCompileShader(FragmentShaderID);
+
+            // Link the program
+#ifdef CE_VERBOSE
+            std::cout << "Linking Program" << std::endl;
+#endif
+            GLuint ProgramID = glCreateProgram();
+            glAttachShader(ProgramID, VertexShaderID);
+            glAttachShader(ProgramID, FragmentShaderID);
+
+            if (cached)
+                glProgramParameteri(ProgramID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+
+            glLinkProgram(ProgramID);
+
+            return ProgramBuild{ ProgramID, VertexShaderID, FragmentShaderID, key, cached };
+        }
+
+        bool GLFunc::end_program(ProgramBuild const& build)
+        {
+            GLint Result = GL_FALSE;
+            int InfoLogLength;
+
+            // Check Vertex Shader
+            glGetShaderiv(build.vertex, GL_INFO_LOG_LENGTH, &InfoLogLength);
+            if (InfoLogLength > 0) {
+                std::vector<char> VertexShaderErrorMessage(InfoLogLength + 1);
+                glGetShaderInfoLog(build.vertex, InfoLogLength, NULL, &VertexShaderErrorMessage[0]);
+                printf("%s\n", &VertexShaderErrorMessage[0]);
+            }
+
+            // Check Fragment Shader
+            glGetShaderiv(build.fragment, GL_INFO_LOG_LENGTH, &InfoLogLength);
+            if (InfoLogLength > 0) {
+                std::vector<char> FragmentShaderErrorMessage(InfoLogLength + 1);
+                glGetShaderInfoLog(build.fragment, InfoLogLength, NULL, &FragmentShaderErrorMessage[0]);
+                printf("%s\n", &FragmentShaderErrorMessage[0]);
+            }
+
+            // Check the program
+            glGetProgramiv(build.program, GL_LINK_STATUS, &Result);
+            glGetProgramiv(build.program, GL_INFO_LOG_LENGTH, &InfoLogLength);
+            if (InfoLogLength > 0) {
+                std::vector<char> ProgramErrorMessage(InfoLogLength + 1);
+                glGetProgramInfoLog(build.program, InfoLogLength, NULL, &ProgramErrorMessage[0]);
+                printf("%s\n", &ProgramErrorMessage[0]);
+            }
+
+            glDetachShader(build.program, build.vertex);
+            glDetachShader(build.program, build.fragment);
+
+            glDeleteShader(build.vertex);
+            glDeleteShader(build.fragment);
+
+            // reflect the uniforms and attributes once, the draws never ask the driver by name
+            if (Result == GL_TRUE)
+            {
+                InternalState::PROGRAMS[build.program] = std::make_unique<ShaderProgram>(build.program);
+
+                if (build.cached)
+                    store_program_binary(build.key, build.program);
+            }
+
+            return Result == GL_TRUE;
+        }
+
+        void GLFunc::SetProgramCache(ProgramCache* cache)
+        {
+            InternalState::PROGRAM_CACHE = cache;
+        }
+
+        std::string GLFunc::inject_defines(std::string const& code, std::string const& defines)
+        {
+            if (defines.empty())
+                return code;
+
+            // the defines must follow the #version line
+            auto const version = code.find("#version");
+            auto const line_end = version != std::string::npos ? code.find('\n', version) : std::string::npos;
+
+            if (line_end == std::string::npos)
+                return defines + "\n" + code;
+
+            return code.substr(0, line_end + 1) + defines + "\n" + code.substr(line_end + 1);
+        }
+
+        std::uint64_t GLFunc::program_key(std::string const& vertex_code, std::string const& fragment_code)
+        {
+            // a binary is only valid for the driver which produced it
+            auto hash = hash_fnv1a(vertex_code.data(), vertex_code.size());
+            hash = hash_fnv1a(fragment_code.data(), fragment_code.size(), hash);
+
+            for (auto const name : { GL_VENDOR, GL_RENDERER, GL_VERSION })
+            {
+                auto const driver = reinterpret_cast<char const*>(glGetString(name));
+                if (driver != nullptr)
+                    hash = hash_fnv1a(driver, std::strlen(driver), hash);
+            }
+
+            return hash;
+        }
+
+        GLuint GLFunc::load_program_binary(std::uint64_t key)
+        {
+            GLenum format;
+            std::vector<char> binary;
+
+            if (!InternalState::PROGRAM_CACHE->find(key, format, binary))
+                return 0;
+
+            GLuint ProgramID = glCreateProgram();
+            glProgramBinary(ProgramID, format, binary.data(), static_cast<GLsizei>(binary.size()));
+
+            GLint Result = GL_FALSE;
+            glGetProgramiv(ProgramID, GL_LINK_STATUS, &Result);
+
+            // the driver may refuse a binary it produced, after an update for instance : compile again
+            if (Result != GL_TRUE)
+            {
+                glDeleteProgram(ProgramID);
+                InternalState::PROGRAM_CACHE->erase(key);
+                return 0;
+            }
+
+#ifdef CE_VERBOSE
+            std::cout << "Loaded program " << ProgramID << " from the program cache." << std::endl;
+#endif
+
+            InternalState::PROGRAMS[ProgramID] = std::make_unique<ShaderProgram>(ProgramID);
+            return ProgramID;
+        }
+
+        void GLFunc::store_program_binary(std::uint64_t key, GLuint program_id)
+        {
+            GLint length = 0;
+            glGetProgramiv(program_id, GL_PROGRAM_BINARY_LENGTH, &length);
+
+            if (length <= 0)
+                return;
+
+            GLenum format;
+            std::vector<char> binary(static_cast<std::size_t>(length));
+            glGetProgramBinary(program_id, length, nullptr, &format, binary.data());
+
+            InternalState::PROGRAM_CACHE->store(key, format, std::move(binary));
+        }
+
+        void GLFunc::reset_state_cache() {
+            // the defaults of a new context
+            InternalState::BINDED_VAO = 0;
+            InternalState::SHADER_PROGRAM_ID = 0;
+            InternalState::ACTIVE_TEXTURE_UNIT = 0;
+            InternalState::READ_FRAMEBUFFER = 0;
+            InternalState::DRAW_FRAMEBUFFER = 0;
+            InternalState::VERTEX_ARRAYS.clear();
+
+            for (auto& bound : InternalState::BOUND_BUFFERS)
+                bound = 0;
+
+            for (auto& unit : InternalState::BOUND_TEXTURES)
+                for (auto& bound : unit)
+                    bound = 0;
+
+            for (auto& bound : InternalState::BOUND_SAMPLERS)
+                bound = 0;
+
+            // the initial viewport and scissor box are the window size : unknown until set
+            InternalState::RASTER = RasterState{
+                { false, false, false, false },
+                GL_ONE, GL_ZERO,
+                GL_LESS, true,
+                GL_BACK,
+                { -1, -1, -1, -1 },
+                { -1, -1, -1, -1 },
+                { 0.0f, 0.0f, 0.0f, 0.0f }
+            };
+        }
+
+        int GLFunc::buffer_slot(GLenum target) {
+            switch (target) {
+            case GL_ARRAY_BUFFER:               return 0;
+            case GL_COPY_READ_BUFFER:           return 1;
+            case GL_COPY_WRITE_BUFFER:          return 2;
+            case GL_PIXEL_PACK_BUFFER:          return 3;
+            case GL_PIXEL_UNPACK_BUFFER:        return 4;
+            case GL_UNIFORM_BUFFER:             return 5;
+            case GL_TEXTURE_BUFFER:             return 6;
+            case GL_TRANSFORM_FEEDBACK_BUFFER:  return 7;
+            default:                            return -1;
+            }
+        }
+
+        int GLFunc::texture_slot(GLenum target) {
+            switch (target) {
+            case GL_TEXTURE_2D:         return 0;
+            case GL_TEXTURE_CUBE_MAP:   return 1;
+            case GL_TEXTURE_2D_ARRAY:   return 2;
+            case GL_TEXTURE_3D:         return 3;
+            default:                    return -1;
+            }
+        }
+
+        int GLFunc::capability_slot(GLenum capability) {
+            switch (capability) {
+            case GL_BLEND:          return 0;
+            case GL_DEPTH_TEST:     return 1;
+            case GL_CULL_FACE:      return 2;
+            case GL_SCISSOR_TEST:   return 3;
+            default:                return -1;
+            }
+        }
+
+        bool GLFunc::vao_is_binded(GLuint vao_id) {
+            return InternalState::BINDED_VAO == vao_id;
+        }
+
+        bool GLFunc::init_glew() {
+
+            if (InternalState::GLEW_INITIALIZED)
+                return true;
+
+#ifdef CE_VERBOSE
+            std::cout << "Initializing GLEW." << std::endl;
+#endif
+
+            glewExperimental = GL_TRUE;
+
+            GLenum error = glewInit();
+
+            if (error != GLEW_OK) {
+                std::cerr << "GLEW error : " << glewGetErrorString(error) << std::endl;
+                glfwTerminate();
+                return false;
+            }
+
+            InternalState::GLEW_INITIALIZED = true;
+
+            // let the driver compile on its own threads, the completion is then asked without blocking
+            if (GLEW_KHR_parallel_shader_compile)
+                glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+            else if (GLEW_ARB_parallel_shader_compile)
+                glMaxShaderCompilerThreadsARB(0xFFFFFFFF);
+
+            InternalState::PARALLEL_COMPILE = GLEW_KHR_parallel_shader_compile || GLEW_ARB_parallel_shader_compile;
+
+#ifdef CE_VERBOSE
+            std::cout << "GLEW initializede successfully." << std::endl;
+#endif
+            return true;
+        }
+
+
+        bool GLFunc::init_glfw() {
+
+            if (InternalState::GLFW_INITIALIZED)
+                return true;
+
+
+#ifdef CE_VERBOSE
+            std::cout << "Initializing GLFW" << std::endl;
+#endif
+
+            glfwSetErrorCallback(show_glfw_error);
+
+            if (!glfwInit()) {
+                std::cerr << "GLFW init failed." << std::endl;
+                return false;
+            }
+
+            glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, CE_OPENGL_MAJOR);
+            glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, CE_OPENGL_MINOR);
+            glfwWindowHint(GLFW_OPENGL_PROFILE, CE_GLFW_OPENGL_PROFILE);
+            glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, CE_GLFW_OPENGL_FORWARD_COMPAT);
+
+            InternalState::GLFW_INITIALIZED = true;
+
+#ifdef CE_VERBOSE
+            std::cout << "GLFW initialized successfully." << std::endl;
+#endif
+            return true;
+        }
+
+        void GLFunc::show_glfw_error(int error, const char* description) {
+            std::cerr << "Error[" << error << "] :" << description << '\n';
+        }
+
+        void GLFunc::TerminateGLFW()
+        {
+            glfwTerminate();
+        }
+
+        void GLFunc::UseShader(GLuint program_id)
+        {
+            assert(InternalState::GLFUNC_READY && "GLFunc is not Ready. CreateContextWindow( ) must be called first.");
+
+            if (!skip_call(program_id == InternalState::SHADER_PROGRAM_ID))
+            {
+#ifdef CE_VERBOSE
+                std::cout << "Setting shader program id to : " << program_id << std::endl;
+#endif
+                glUseProgram(program_id);
+                InternalState::SHADER_PROGRAM_ID = program_id;
+            }
+        }
+
+        void GLFunc::DeleteProgram(GLuint program_id)
+        {
+            assert(InternalState::GLFUNC_READY && "GLFunc is not Ready. CreateContextWindow( ) must be called first.");
+
+            if (InternalState::SHADER_PROGRAM_ID == program_id)
+                InternalState::SHADER_PROGRAM_ID = 0;
+
+            InternalState::PROGRAMS.erase(program_id);
+            glDeleteProgram(program_id);
+        }
+
+        ShaderProgram* GLFunc::GetProgram(GLuint program_id)
+        {
+            auto found = InternalState::PROGRAMS.find(program_id);
+            return found != InternalState::PROGRAMS.end() ? found->second.get() : nullptr;
+        }
+
+        GLuint GLFunc::GetShaderMatrixID(GLuint program_id, std::string matrix_name)
+        {
+            assert(InternalState::GLFUNC_READY && "GLFunc is not Ready. CreateContextWindow( ) must be called first.");
+            assert(program_id != 0 && "Shader program id is not valid.");
+               
+            return glGetUniformLocation(program_id, matrix_name.c_str());
+        }
+
+        void GLFunc::BindShaderMatrixData(GLuint matrix_id, float* data)
+        {
+            assert(InternalState::GLFUNC_READY && "GLFunc is not Ready. CreateContextWindow( ) must be called first.");
+            assert(matrix_id != -1 && "Shader matrix id is not valid.");
+
+            glUniformMatrix4fv(matrix_id, 1, GL_FALSE, data);
+        }
+
+        void GLFunc::DrawArrays(GLenum mode, GLint start, GLsizei count)
+        {
+            assert(InternalState::GLFUNC_READY && "GLFunc is not Ready. CreateContextWindow( ) must be called first.");
+            assert(InternalState::BINDED_VAO != 0 && "There is no binded vao.");
+
+            glDrawArrays(mode, start, count);
+        }
+
+        void GLFunc::DrawArraysInstanced(GLenum mode, GLint start, GLsizei count, GLsizei instances)
+        {
+            assert(InternalState::GLFUNC_READY && "GLFunc is not Ready. CreateContextWindow( ) must be called first.");
+            assert(InternalState::BINDED_VAO != 0 && "There is no binded vao.");
+
+            glDrawArraysInstanced(mode, start, count, instances);
+        }
+
+        void GLFunc::DrawElements(GLenum mode, GLsizei count, GLenum index_type, GLintptr offset)
+        {
+            assert(InternalState::GLFUNC_READY && "GLFunc is not Ready. CreateContextWindow( ) must be called first.");
+            assert(InternalState::BINDED_VAO != 0 && "There is no binded vao.");
+
+            glDrawElements(mode, count, index_type, reinterpret_cast<void*>(offset));
+        }
+
+        void GLFunc::DrawElementsInstanced(GLenum mode, GLsizei count, GLenum index_type, GLintptr offset, GLsizei instances)
+        {
+            assert(InternalState::GLFUNC_READY && "GLFunc is not Ready. CreateContextWindow( ) must be called first.");
+            assert(InternalState::BINDED_VAO != 0 && "There is no binded vao.");
+
+            glDrawElementsInstanced(mode, count, index_type, reinterpret_cast<void*>(offset), instances);
+        }
+
+        bool GLFunc::WindowShouldClose(GLFWwindow* w)
+        {
+            return w != nullptr ? glfwWindowShouldClose(w) : false;
+        }
+
+    }
+}
+
@@ -0,0 +1,72 @@
+#ifndef BUFFER_MANAGER_H_INCLUDED
+#define BUFFER_MANAGER_H_INCLUDED
+
+#include <GL/glew.h>
+
+#include <vector>
+
+namespace ce {
+	namespace Graphic {
+
+		/// <summary>
+		///		How often the content of a buffer is replaced
+		/// </summary>
+		enum class BufferUsage {
+			STATIC,		// uploaded once
+			DYNAMIC,	// replaced a few times
+			STREAM		// replaced every frame or more
+		};
+
+		// index in the manager, stable for the buffer lifetime
+		using BufferHandle = std::size_t;
+		const BufferHandle CE_INVALID_BUFFER = static_cast<BufferHandle>(-1);
+
+		/// <summary>
+		///		Own the GL buffer objects : create them once, update them in place,
+		///		and recycle the deleted ones instead of asking the driver for new names.
+		/// </summary>
+		class BufferManager {
+			public:
+				BufferManager();
+				~BufferManager();
+
+				// not copyable
+				BufferManager(BufferManager const&) = delete;
+				BufferManager& operator=(BufferManager const&) = delete;
+
+				// movable
+				BufferManager(BufferManager&& other) noexcept;
+				BufferManager& operator=(BufferManager&& other) noexcept;
+
+				BufferHandle create(GLenum target, BufferUsage usage, GLsizeiptr size, const void* data = nullptr);
+				void update(BufferHandle buffer, GLsizeiptr size, const void* data);
+				void destroy(BufferHandle buffer);
+				void clear();
+
+				GLuint id(BufferHandle buffer) const;
+				GLsizeiptr size(BufferHandle buffer) const;
+
+				// GPU memory held by the live and recycled buffers
+				GLsizeiptr allocatedBytes() const { return AllocatedBytes_; }
+				std::size_t liveBuffers() const { return Buffers_.size() - Free_.size(); }
+
+			private:
+				struct Buffer {
+					GLuint id;
+					GLenum target;
+					BufferUsage usage;
+					GLsizeiptr capacity;	// storage size on the GPU
+					GLsizeiptr size;		// bytes in use
+					bool alive;
+				};
+
+				static GLenum gl_usage(BufferUsage usage);
+
+				std::vector<Buffer> Buffers_;
+				std::vector<BufferHandle> Free_;
+				GLsizeiptr AllocatedBytes_;
+		};
+	}
+}
+
+#endif
@@ -1,24 +1,59 @@
-#ifndef CORE_COMPONENTS_H_INCLUDED
-#define CORE_COMPONENTS_H_INCLUDED
-
-#include "base_component.h"
-#include "entity.h"
-
-namespace ce {
-	namespace Core {
-
-		const CType NODE_TYPE = "NODE";
-
-		class Node : public BComponent {
-		public:
-			Node(Entity o, float xpos, float ypos, float zpos) : BComponent{o, NODE_TYPE} , x{xpos}, y{ypos}, z{zpos}
-			{};
-			float x;
-			float y;
-			float z;
-		};
-
-	}
-}
-
+#ifndef CORE_COMPONENTS_H_INCLUDED
+#define CORE_COMPONENTS_H_INCLUDED
+
+#include <cstddef>
+
+#include "base_component.h"
+#include "colors.h"
+#include "entity.h"
+#include "utils.h"
+
+namespace ce {
+	namespace Core {
+
+		const CType NODE_TYPE = "NODE";
+
+		class Node : public BComponent {
+		public:
+			Node(Entity o, float xpos, float ypos, float zpos) : BComponent{o, NODE_TYPE} , x{xpos}, y{ypos}, z{zpos}
+			{};
+			float x;
+			float y;
+			float z;
+		};
+
+		const CType RENDERABLE_TYPE = "RENDERABLE";
+
+		/// <summary>
+		///		Draws the entity at its Node position with a registered mesh.
+		///		Entities sharing a mesh are drawn together in one instanced call.
+		/// </summary>
+		class Renderable : public BComponent {
+		public:
+			Renderable(Entity o, std::size_t mesh_id, color<float> tint_color) : BComponent{o, RENDERABLE_TYPE}, mesh{mesh_id}, tint{tint_color}
+			{};
+			std::size_t mesh;	// id given by the renderer mesh registry
+			color<float> tint;	// material color
+		};
+
+		const CType BOUNDS_TYPE = "BOUNDS";
+
+		/// <summary>
+		///		Volume around the Node position, used to skip the entities outside of the view.
+		///		A sphere, an axis aligned box, or both : the box is grown by the radius.
+		///		Renderables without Bounds are always drawn.
+		/// </summary>
+		class Bounds : public BComponent {
+		public:
+			Bounds(Entity o, float sphere_radius) : BComponent{o, BOUNDS_TYPE}, radius{sphere_radius}, half_extents{0.0f, 0.0f, 0.0f}
+			{};
+			Bounds(Entity o, fVec3 box_half_extents) : BComponent{o, BOUNDS_TYPE}, radius{0.0f}, half_extents{box_half_extents}
+			{};
+			float radius;
+			fVec3 half_extents;
+		};
+
+	}
+}
+
 #endif
\ No newline at end of file
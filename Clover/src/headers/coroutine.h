@@ -0,0 +1,196 @@
+#ifndef COROUTINE_H_INCLUDED
+#define COROUTINE_H_INCLUDED
+
+#include <atomic>
+#include <coroutine>
+#include <exception>
+#include <string>
+
+#include "system.h"
+#include "job_system.h"
+
+namespace ce {
+	namespace Core {
+
+		class Scheduler;
+
+		/// <summary>
+		///		Recycles coroutine frames by size class so starting a task
+		///		only hits the heap the first time a frame size is needed.
+		/// </summary>
+		class FramePool {
+			public:
+				static void* allocate(std::size_t size);
+				static void release(void* frame, std::size_t size);
+		};
+
+		/// <summary>
+		///		Coroutine running on a Scheduler. Use co_await NextFrame{}, Seconds{ s }
+		///		LoadAsync{ path } or another Task inside the body.
+		/// </summary>
+		class Task {
+			public:
+				struct promise_type;
+				using Handle = std::coroutine_handle<promise_type>;
+
+				/// <summary>
+				///		Resume the awaiting task when a child task ends,
+				///		give the frame back to the pool when a root task ends.
+				/// </summary>
+				struct FinalAwaiter {
+					bool await_ready() noexcept { return false; }
+					std::coroutine_handle<> await_suspend(Handle h) noexcept;
+					void await_resume() noexcept {}
+				};
+
+				struct promise_type {
+					Task get_return_object() { return Task{ Handle::from_promise(*this) }; }
+					std::suspend_always initial_suspend() noexcept { return {}; }
+					FinalAwaiter final_suspend() noexcept { return {}; }
+					void return_void() {}
+					void unhandled_exception() { Exception_ = std::current_exception(); }
+
+					static void* operator new(std::size_t size) { return FramePool::allocate(size); }
+					static void operator delete(void* frame, std::size_t size) { FramePool::release(frame, size); }
+
+					// scheduler running this task, inherited by awaited child tasks
+					Scheduler* Scheduler_ = nullptr;
+
+					// task to resume when this one ends, null for root tasks
+					std::coroutine_handle<> Continuation_{};
+
+					// intrusive links so the scheduler never allocates to park a task
+					promise_type* Next_ = nullptr;
+					double WakeTime_ = 0.0;
+
+					// root tasks list, destroyed with the scheduler
+					promise_type* RootPrev_ = nullptr;
+					promise_type* RootNext_ = nullptr;
+
+					std::exception_ptr Exception_{};
+				};
+
+				Task() : Handle_{} {}
+				~Task();
+
+				// not copyable
+				Task(Task const&) = delete;
+				Task& operator=(Task const&) = delete;
+
+				// movable
+				Task(Task&& other) noexcept;
+				Task& operator=(Task&& other) noexcept;
+
+				bool done() const { return !Handle_ || Handle_.done(); }
+
+				// awaiting a task runs it to completion before resuming the caller
+				bool await_ready() const noexcept { return done(); }
+				std::coroutine_handle<> await_suspend(Handle caller) noexcept;
+				void await_resume();
+
+			private:
+				friend class Scheduler;
+
+				explicit Task(Handle h) : Handle_{ h } {}
+				Handle release();
+
+				Handle Handle_;
+		};
+
+		/// <summary>
+		///		Resume the task at the next scheduler update
+		/// </summary>
+		struct NextFrame {
+			bool await_ready() const noexcept { return false; }
+			void await_suspend(Task::Handle h) noexcept;
+			void await_resume() const noexcept {}
+		};
+
+		/// <summary>
+		///		Resume the task once the scheduler clock advanced by the given amount of seconds
+		/// </summary>
+		struct Seconds {
+			double Duration;
+
+			bool await_ready() const noexcept { return Duration <= 0.0; }
+			void await_suspend(Task::Handle h) noexcept;
+			void await_resume() const noexcept {}
+		};
+
+		/// <summary>
+		///		Read a whole file on the scheduler job system and resume with its content.
+		///		The content is empty when the file can not be read.
+		/// </summary>
+		class LoadAsync {
+			public:
+				LoadAsync(std::string path) : Path_{ std::move(path) }, Content_{} {}
+
+				bool await_ready() const noexcept { return false; }
+				bool await_suspend(Task::Handle h);
+				std::string await_resume() { return std::move(Content_); }
+
+			private:
+				std::string Path_;
+				std::string Content_;
+		};
+
+		/// <summary>
+		///		Resume the suspended tasks, owned and updated by the frame loop.
+		/// </summary>
+		class Scheduler : public System {
+			public:
+
+				// jobs is used by LoadAsync, files are read in place without one
+				Scheduler(JobSystem* jobs = nullptr);
+				~Scheduler();
+
+				// not copyable
+				Scheduler(Scheduler const&) = delete;
+				Scheduler& operator=(Scheduler const&) = delete;
+
+				// not movable, parked tasks keep a pointer on the scheduler
+				Scheduler(Scheduler&&) = delete;
+				Scheduler& operator=(Scheduler&&) = delete;
+
+				// take ownership of the task and run it until its first suspension
+				void start(Task task);
+
+				// time_delta in milliseconds
+				void update(int time_delta);
+
+				double time() const { return Time_; }
+				std::size_t frame() const { return Frame_; }
+				std::size_t taskCount() const { return Running_; }
+
+			private:
+				friend struct Task::FinalAwaiter;
+				friend struct NextFrame;
+				friend struct Seconds;
+				friend class LoadAsync;
+
+				using Promise = Task::promise_type;
+
+				void parkNextFrame(Promise* p);
+				void parkTimer(Promise* p);
+				void parkLoaded(Promise* p);
+				void resume(Promise* p);
+				void retire(Promise* p);
+
+				JobSystem* Jobs_;
+
+				Promise* Roots_;
+
+				Promise* NextFrame_;
+				Promise* Timers_; // sorted by wake time
+				std::atomic<Promise*> Loaded_; // pushed by the job system workers
+
+				std::exception_ptr Failed_;
+
+				double Time_;
+				std::size_t Frame_;
+				std::size_t Running_;
+		};
+	}
+}
+
+#endif
@@ -1,12 +1,12 @@
-#ifndef ENTITY_H_INCLUDED
-#define ENTITY_H_INCLUDED
-
-namespace ce {
-	namespace Core {
-
-		using Entity = std::size_t;
-
-	}
-}
-
-#endif
+#ifndef ENTITY_H_INCLUDED
+#define ENTITY_H_INCLUDED
+
+namespace ce {
+	namespace Core {
+
+		using Entity = std::size_t;
+
+	}
+}
+
+#endif
@@ -0,0 +1,302 @@
+#ifndef EVENT_BUS_H_INCLUDED
+#define EVENT_BUS_H_INCLUDED
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+#include "mpsc_queue.h"
+
+namespace ce {
+	namespace Event {
+
+		using EventTypeId = std::size_t;
+
+		/// <summary>
+		///		Hands out dense ids to event types, see event_type_id
+		/// </summary>
+		class EventTypeIds {
+			public:
+				static EventTypeId next();
+		};
+
+		/// <summary>
+		///		Dense id of an event type, used to index the bus channels.
+		///		Any struct can be an event type, the id is set the first time the type is used.
+		/// </summary>
+		template<class T>
+		EventTypeId event_type_id()
+		{
+			static EventTypeId const id = EventTypeIds::next();
+			return id;
+		}
+
+		/// <summary>
+		///		Non owning callable bound to a free function or to a member function and its instance.
+		///		Calling it is a plain function pointer call, no virtual dispatch.
+		/// </summary>
+		/// <typeparam name="T">Event type</typeparam>
+		template<class T>
+		struct Delegate {
+			void* instance;
+			void (*call)(void*, T const&);
+
+			void operator()(T const& event) const { call(instance, event); }
+
+			template<class C, void (C::*Method)(T const&)>
+			static Delegate bind(C* c)
+			{
+				return Delegate{ c, [](void* i, T const& e) { (static_cast<C*>(i)->*Method)(e); } };
+			}
+
+			template<void (*Function)(T const&)>
+			static Delegate bind()
+			{
+				return Delegate{ nullptr, [](void*, T const& e) { Function(e); } };
+			}
+		};
+
+		/// <summary>
+		///		Type erased part of a channel, used to flush every queued type
+		/// </summary>
+		class BaseChannel {
+			public:
+				virtual ~BaseChannel() {}
+				virtual void flush() = 0;
+		};
+
+		/// <summary>
+		///		Delegates and queued events of one event type, stored contiguously
+		/// </summary>
+		/// <typeparam name="T">Event type</typeparam>
+		template<class T>
+		class Channel : public BaseChannel {
+			public:
+				Channel() : Delegates_{}, Queue_{}, Flushing_{}, Dispatching_{ 0 }, Removed_{ false } {}
+
+				void add(Delegate<T> d) { Delegates_.push_back(d); }
+
+				/// <summary>
+				///		Remove the delegates matching. While dispatching they are only disabled
+				///		and the array is compacted once the dispatch is over.
+				/// </summary>
+				void remove(Delegate<T> d)
+				{
+					for (auto& bound : Delegates_)
+						if (bound.call == d.call && bound.instance == d.instance)
+						{
+							bound.call = nullptr;
+							Removed_ = true;
+						}
+
+					compact();
+				}
+
+				/// <summary>
+				///		Call every delegate now
+				/// </summary>
+				void publish(T const& event)
+				{
+					++Dispatching_;
+
+					// index loop : delegates bound during the dispatch may grow the array
+					auto const count = Delegates_.size();
+					for (std::size_t i = 0; i < count; ++i)
+						if (Delegates_[i].call != nullptr)
+							Delegates_[i](event);
+
+					--Dispatching_;
+					compact();
+				}
+
+				/// <summary>
+				///		Queue the event for the next flush. Tells if the queue was empty.
+				/// </summary>
+				bool enqueue(T const& event)
+				{
+					Queue_.push_back(event);
+					return Queue_.size() == 1;
+				}
+
+				/// <summary>
+				///		Publish the queued events. Events queued meanwhile wait for the next flush.
+				/// </summary>
+				void flush()
+				{
+					Flushing_.swap(Queue_);
+
+					for (auto const& event : Flushing_)
+						publish(event);
+
+					Flushing_.clear();
+				}
+
+				std::size_t delegateCount() const { return Delegates_.size(); }
+
+			private:
+				void compact()
+				{
+					if (Dispatching_ != 0 || !Removed_)
+						return;
+
+					std::size_t kept = 0;
+					for (std::size_t i = 0; i < Delegates_.size(); ++i)
+						if (Delegates_[i].call != nullptr)
+							Delegates_[kept++] = Delegates_[i];
+
+					Delegates_.resize(kept);
+					Removed_ = false;
+				}
+
+				std::vector<Delegate<T>> Delegates_;
+				std::vector<T> Queue_;
+				std::vector<T> Flushing_; // keeps its capacity between flushes
+				int Dispatching_;
+				bool Removed_;
+		};
+
+		class EventBus;
+
+		// largest event that can be posted from another thread, and how many can wait
+		const std::size_t CE_POSTED_EVENT_SIZE = 48;
+		const std::size_t CE_POSTED_EVENT_QUEUE_SIZE = 4096;
+
+		/// <summary>
+		///		Event copied by value into the cross-thread queue with the function that publishes it
+		/// </summary>
+		struct PostedEvent {
+			void (*deliver)(EventBus&, void const*);
+			alignas(std::max_align_t) unsigned char data[CE_POSTED_EVENT_SIZE];
+		};
+
+		using PostedEventQueue = ce::Core::MpscQueue<PostedEvent, CE_POSTED_EVENT_QUEUE_SIZE>;
+
+		/// <summary>
+		///		Publish events of any type to the delegates subscribed to that type.
+		///		Events are delivered right away with publish, or queued with enqueue until flush.
+		///		Not thread safe, use it from the thread that runs the frame loop,
+		///		except post which any thread may call.
+		/// </summary>
+		class EventBus {
+			public:
+				EventBus();
+
+				// not copyable
+				EventBus(EventBus const&) = delete;
+				EventBus& operator=(EventBus const&) = delete;
+
+				// movable
+				EventBus(EventBus&& other) noexcept;
+				EventBus& operator=(EventBus&& other) noexcept;
+
+				// subscribe a member function, ie. subscribe<DamageEvent, &Health::onDamage>(&health)
+				template<class T, auto Method, class C>
+				void subscribe(C* instance)
+				{
+					channel<T>().add(Delegate<T>::template bind<C, Method>(instance));
+				}
+
+				template<class T, void (*Function)(T const&)>
+				void subscribe()
+				{
+					channel<T>().add(Delegate<T>::template bind<Function>());
+				}
+
+				template<class T, auto Method, class C>
+				void unsubscribe(C* instance)
+				{
+					channel<T>().remove(Delegate<T>::template bind<C, Method>(instance));
+				}
+
+				template<class T, void (*Function)(T const&)>
+				void unsubscribe()
+				{
+					channel<T>().remove(Delegate<T>::template bind<Function>());
+				}
+
+				// immediate delivery
+				template<class T>
+				void publish(T const& event)
+				{
+					channel<T>().publish(event);
+				}
+
+				// deferred delivery, at the next flush
+				template<class T>
+				void enqueue(T const& event)
+				{
+					auto& c = channel<T>();
+
+					if (c.enqueue(event))
+						Pending_.push_back(&c);
+				}
+
+				// deliver the queued events, type by type
+				void flush();
+
+				/// <summary>
+				///		Thread safe. Queue the event for the next drainPosted, events posted by a
+				///		thread are published in the order it posted them. Fails when the queue is full.
+				/// </summary>
+				template<class T>
+				bool post(T const& event)
+				{
+					static_assert(std::is_trivially_copyable_v<T>, "Posted events are copied as bytes through the queue.");
+					static_assert(sizeof(T) <= CE_POSTED_EVENT_SIZE, "Event too large to be posted, raise CE_POSTED_EVENT_SIZE.");
+					static_assert(alignof(T) <= alignof(std::max_align_t), "Event too aligned to be posted.");
+
+					// the event is copy constructed in place, no default constructor needed
+					PostedEvent posted;
+					posted.deliver = [](EventBus& bus, void const* data) {
+						bus.publish(*std::launder(static_cast<T const*>(data)));
+					};
+					::new (static_cast<void*>(posted.data)) T(event);
+
+					if (Posted_->push(posted))
+						return true;
+
+					DroppedPosts_.fetch_add(1, std::memory_order_relaxed);
+					return false;
+				}
+
+				// publish the posted events, returns how many
+				std::size_t drainPosted();
+
+				// posts refused because the queue was full, since the last call
+				std::size_t droppedPosts() { return DroppedPosts_.exchange(0, std::memory_order_relaxed); }
+
+				template<class T>
+				std::size_t subscriberCount()
+				{
+					return channel<T>().delegateCount();
+				}
+
+			private:
+				template<class T>
+				Channel<T>& channel()
+				{
+					auto const id = event_type_id<T>();
+
+					if (id >= Channels_.size())
+						Channels_.resize(id + 1);
+
+					if (!Channels_[id])
+						Channels_[id] = std::make_unique<Channel<T>>();
+
+					return *static_cast<Channel<T>*>(Channels_[id].get());
+				}
+
+				std::vector<std::unique_ptr<BaseChannel>> Channels_; // indexed by event type id
+				std::vector<BaseChannel*> Pending_; // channels with queued events
+				std::vector<BaseChannel*> Flushing_;
+
+				std::unique_ptr<PostedEventQueue> Posted_;
+				std::atomic<std::size_t> DroppedPosts_;
+		};
+	}
+}
+
+#endif
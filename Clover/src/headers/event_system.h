@@ -1,96 +1,241 @@
-#ifndef EVENT_SYSTEM_H_INCLUDED
-#define EVENT_SYSTEM_H_INCLUDED
-
-#include <vector>
-
-#include "system.h"
-#include "event_keys.h"
-#include "window.h"
-
-namespace ce {
-	namespace Event {
-		struct MousePosition {
-			int x;
-			int y;
-		};
-
-		/// <summary>
-		///		Generic event struct
-		/// </summary>
-		/// <typeparam name="action_type">action type</typeparam>
-		/// <typeparam name="key_type">key type</typeparam>
-		template<class action_type, class key_type>
-		struct Event {
-			action_type action;
-			key_type key;
-			MousePosition mouse;
-		};
-
-		// Event types
-		using KbEvent = Event<ceKbActionType, ceKbKeyType>;
-		using MouseMovedEvent = Event<ceMouseMovedType, int>;
-		using MouseActionEvent = Event<ceMouseActionType, ceMouseButtonType>;
-
-		/// <summary>
-		///		Generic Listener class
-		/// </summary>
-		/// <typeparam name="T"></typeparam>
-		template<class T>
-		class Listener {
-			public:
-				virtual void receive(T) = 0;
-		};
-
-		// listener types
-		using KbListener = Listener<KbEvent>;
-		using MouseMovedListener = Listener<MouseMovedEvent>;
-		using MouseActionListener = Listener<MouseActionEvent>;
-		
-
-		/// <summary>
-		///		Receive and dispatch events emitted by GLFW
-		/// </summary>
-		class glEventSystem : public ce::Core::System {
-			public:
-
-				// constructor
-				glEventSystem(ce::Graphic::ceWindow::ceRenderer* w);
-
-				// not copyable
-				glEventSystem(glEventSystem const&) = delete;
-				glEventSystem& operator=(glEventSystem const&) = delete;
-
-				// movable
-				glEventSystem(glEventSystem&& other) noexcept;
-				glEventSystem& operator=(glEventSystem&& other) noexcept;
-
-				void update(int);
-
-				// bind functions
-				void bindKeyPressedListener(KbListener* listener);
-				void bindMouseMovedListener(MouseMovedListener* listener);
-				void bindMouseActionListener(MouseActionListener* listener);
-
-			private:
-				// static callbacks for glfw
-				static void kb_action_callback(GLFWwindow* window, int key, int scancode, int action, int mods);
-				static void mouse_moved_callback(GLFWwindow* window, double xpos, double ypos);
-				static void mouse_action_callback(GLFWwindow* window, int button, int action, int mods);
-				static void window_resized_callback(GLFWwindow* wind, int width, int height);
-				
-				// send functions
-				void sendKbEvent(GLFWwindow* window, int key, int scancode, int action, int mods);
-				void sendMouseMovedEvent(GLFWwindow* window, int xpos, int ypos);
-				void sendMouseActionEvent(GLFWwindow* window, int button, int action, int mods);
-
-				// listeners list
-				std::vector<KbListener*> KeyboardListeners_;
-				std::vector<MouseMovedListener*> MouseMovedListeners_;
-				std::vector<MouseActionListener*> MouseActionListeners_;
-
-				ce::Graphic::ceWindow::ceRenderer* bindedWindow_;
-		};
-	}
-}
-
-#endif
+#ifndef EVENT_SYSTEM_H_INCLUDED
+#define EVENT_SYSTEM_H_INCLUDED
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "system.h"
+#include "event_bus.h"
+#include "event_keys.h"
+#include "input_record.h"
+#include "input_state.h"
+#include "ring_buffer.h"
+#include "window.h"
+
+namespace ce {
+	namespace Event {
+		struct MousePosition {
+			int x;
+			int y;
+		};
+
+		/// <summary>
+		///		Generic event struct
+		/// </summary>
+		/// <typeparam name="action_type">action type</typeparam>
+		/// <typeparam name="key_type">key type</typeparam>
+		template<class action_type, class key_type>
+		struct Event {
+			action_type action;
+			key_type key;
+			MousePosition mouse;
+		};
+
+		/// <summary>
+		///		Mouse motion at full precision. When coalescing, one event sums
+		///		every sample received since the previous dispatch.
+		/// </summary>
+		struct MouseMovedEvent {
+			ceMouseMovedType action;
+			double x;		// latest position
+			double y;
+			double dx;		// motion since the previous mouse moved event
+			double dy;
+			int samples;	// number of OS samples merged in this event
+		};
+
+		// Event types
+		using KbEvent = Event<ceKbActionType, ceKbKeyType>;
+		using MouseActionEvent = Event<ceMouseActionType, ceMouseButtonType>;
+
+		/// <summary>
+		///		Generic Listener class
+		/// </summary>
+		/// <typeparam name="T"></typeparam>
+		template<class T>
+		class Listener {
+			public:
+				virtual void receive(T) = 0;
+		};
+
+		// listener types
+		using KbListener = Listener<KbEvent>;
+		using MouseMovedListener = Listener<MouseMovedEvent>;
+		using MouseActionListener = Listener<MouseActionEvent>;
+
+		// key binding filters
+		const int CE_ANY_ACTION = -1;
+		const int CE_ANY_MODS = -1;
+
+		/// <summary>
+		///		Listener bound to one key, for an action and a modifier set
+		/// </summary>
+		struct KeyBinding {
+			KbListener* listener;
+			int action;
+			int mods;
+		};
+
+		/// <summary>
+		///		Kind of event recorded by the GLFW callbacks
+		/// </summary>
+		enum class RawEventType : std::uint8_t {
+			KEY,
+			MOUSE_MOVED,
+			MOUSE_ACTION,
+			WINDOW_RESIZED
+		};
+
+		/// <summary>
+		///		Compact timestamped event pushed by the GLFW callbacks and dispatched by the event system
+		/// </summary>
+		struct RawEvent {
+			double time;		// glfwGetTime() when the event was received
+			RawEventType type;
+			int key;			// keyboard key or mouse button, new width for resizes, merged samples for mouse moves
+			int action;			// new height for resizes
+			int mods;
+			double x;			// mouse position
+			double y;
+			double dx;			// mouse motion since the previous mouse moved event
+			double dy;
+		};
+
+		// events received between two dispatches, the overflow is dropped and counted
+		const std::size_t CE_EVENT_QUEUE_SIZE = 1024;
+		using EventQueue = ce::Core::SpscRing<RawEvent, CE_EVENT_QUEUE_SIZE>;
+
+		/// <summary>
+		///		Measures of the last dispatch
+		/// </summary>
+		struct DispatchStats {
+			std::size_t dispatched;
+			std::size_t dropped;
+			double dispatch_ms;
+		};
+		
+
+		/// <summary>
+		///		Receive and dispatch events emitted by GLFW
+		/// </summary>
+		class glEventSystem : public ce::Core::System {
+			public:
+
+				// constructor
+				glEventSystem(ce::Graphic::ceWindow::ceRenderer* w);
+
+				// not copyable
+				glEventSystem(glEventSystem const&) = delete;
+				glEventSystem& operator=(glEventSystem const&) = delete;
+
+				// movable
+				glEventSystem(glEventSystem&& other) noexcept;
+				glEventSystem& operator=(glEventSystem&& other) noexcept;
+
+				// poll the events, and dispatch them unless dispatch on update is disabled
+				void update(int);
+
+				// send the queued events to the listeners, may run on another thread than update
+				void dispatch();
+				void setDispatchOnUpdate(bool dispatch_on_update) { DispatchOnUpdate_ = dispatch_on_update; }
+				DispatchStats lastDispatch() const { return LastDispatch_; }
+
+				// publish the events posted to the bus by other threads at each dispatch
+				void bindEventBus(EventBus* bus) { Bus_ = bus; }
+
+				// replace glfwPollEvents by another source, null to poll the window again
+				void setEventSource(EventSource* source) { Source_ = source; }
+
+				// queue an event as if the window sent it, from the polling thread
+				void inject(RawEvent const& event) { queueEvent(event); }
+
+				// write every dispatched frame to the recorder, null to stop recording
+				void setRecorder(InputRecorder* recorder) { Recorder_ = recorder; }
+
+				// state of the last dispatched frame, for the dispatching thread
+				InputState const& input() const { return *Input_; }
+
+				// same state, safe to keep and read from any thread
+				std::shared_ptr<const InputState> inputSnapshot() const { return Published_.load(std::memory_order_acquire); }
+
+				// mouse options
+				void setMouseCoalescing(bool coalesce) { CoalesceMouse_ = coalesce; }
+				bool setRawMouseMotion(bool raw);
+
+				// bind functions, from the thread that dispatches
+				void bindKeyPressedListener(KbListener* listener);
+				void bindMouseMovedListener(MouseMovedListener* listener);
+				void bindMouseActionListener(MouseActionListener* listener);
+
+				// receive only the events of a key, ie. bindKey(CE_KEY_SPACE, CE_KEY_PRESSED, listener)
+				void bindKey(ceKbKeyType key, int action, KbListener* listener, int mods = CE_ANY_MODS);
+
+				// unbind functions, safe from inside a listener
+				void unbindKey(ceKbKeyType key, KbListener* listener);
+				void unbindKeyPressedListener(KbListener* listener);
+				void unbindMouseMovedListener(MouseMovedListener* listener);
+				void unbindMouseActionListener(MouseActionListener* listener);
+
+			private:
+				// static callbacks for glfw
+				static void kb_action_callback(GLFWwindow* window, int key, int scancode, int action, int mods);
+				static void mouse_moved_callback(GLFWwindow* window, double xpos, double ypos);
+				static void mouse_action_callback(GLFWwindow* window, int button, int action, int mods);
+				static void window_resized_callback(GLFWwindow* wind, int width, int height);
+				
+				// queue an event, called by the callbacks only
+				void queueEvent(RawEvent const& event);
+				void queueMouseMotion();
+
+				// send functions
+				void sendKbEvent(RawEvent const& event);
+				void sendMouseMovedEvent(RawEvent const& event);
+				void sendMouseActionEvent(RawEvent const& event);
+
+				// listeners list
+				std::vector<KbListener*> KeyboardListeners_;
+				std::vector<MouseMovedListener*> MouseMovedListeners_;
+				std::vector<MouseActionListener*> MouseActionListeners_;
+
+				// key bindings indexed by key code
+				std::vector<std::vector<KeyBinding>> KeyBindings_;
+
+				// unbinded listeners are set to null while dispatching, and removed after
+				void compactListeners();
+				bool Dispatching_;
+				bool Unbinded_;
+
+				// filled by the callbacks, emptied by dispatch
+				std::unique_ptr<EventQueue> Queue_;
+				std::atomic<std::size_t> DroppedEvents_;
+
+				// events of the current dispatch, kept to reuse its memory
+				std::vector<RawEvent> Batch_;
+
+				// input state built by dispatch, copied and published once per frame
+				InputState State_;
+				std::shared_ptr<const InputState> Input_;
+				std::atomic<std::shared_ptr<const InputState>> Published_;
+
+				bool DispatchOnUpdate_;
+				DispatchStats LastDispatch_;
+
+				EventSource* Source_;
+				InputRecorder* Recorder_;
+				EventBus* Bus_;
+
+				// mouse samples merged until the end of the poll
+				bool CoalesceMouse_;
+				bool HasCursor_;
+				RawEvent Motion_;
+
+				// resized by the dispatched resize events, live or replayed, headless included
+				ce::Graphic::ceWindow::ceRenderer* Renderer_;
+				ce::Graphic::ceWindow::ceRenderer* bindedWindow_;
+		};
+	}
+}
+
+#endif
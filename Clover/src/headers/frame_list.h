@@ -0,0 +1,89 @@
+#ifndef FRAME_LIST_H_INCLUDED
+#define FRAME_LIST_H_INCLUDED
+
+#include <GL/glew.h>
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "colors.h"
+#include "mesh.h"
+#include "mesh_file.h"
+#include "primitive_batch.h"
+#include "render_queue.h"
+#include "texture_manager.h"
+#include "utils.h"
+
+namespace ce {
+	namespace Graphic {
+
+		/// <summary>
+		///		What a recorded operation does when the frame is executed
+		/// </summary>
+		enum class FrameOpType {
+			UPLOAD_MESH,		// mesh vertices [first, first + count)
+			UPLOAD_MESH_FILE,	// mapped mesh file first
+			SET_CLEAR_COLOR,
+			CLEAR,				// draws the queued commands first
+			DRAW_BATCH,			// batch vertices [first, first + count)
+			DRAW_INSTANCED,		// instances [first, first + count) of a mesh
+			BIND_TEXTURE,		// texture first on unit count, draws the queued commands first
+			FLUSH,				// draws the queued commands
+			PRESENT				// draws the queued commands then swaps the buffers
+		};
+
+		/// <summary>
+		///		One recorded operation, the data it points to lives in the frame list arrays
+		/// </summary>
+		struct FrameOp {
+			FrameOpType type;
+			SortKey key;
+			GLenum mode;
+			MeshId mesh;
+			std::size_t first;
+			std::size_t count;
+			std::uint32_t transform;	// in the frame transforms, CE_NO_TRANSFORM if none
+			color<float> clear_color;
+		};
+
+		/// <summary>
+		///		A frame recorded without any GL call, so it can be executed by another thread.
+		///		Everything the execution needs is copied in : vertices, instances and transforms.
+		/// </summary>
+		struct FrameList {
+			std::vector<FrameOp> ops;
+			std::vector<BatchVertex> vertices;
+			std::vector<InstanceData> instances;
+			std::vector<Core::fVec3> mesh_vertices;
+			std::vector<glm::mat4> transforms;
+			std::vector<std::shared_ptr<MeshFile>> mesh_files;	// unmapped once uploaded and cleared
+
+			// filled by the execution
+			std::size_t draw_calls = 0;
+			std::size_t state_changes = 0;
+			std::size_t redundant_calls = 0;
+			std::vector<TextureId> textures_ready;		// uploaded by this frame
+
+			// forget the frame, the memory is kept for the next one
+			void clear()
+			{
+				ops.clear();
+				vertices.clear();
+				instances.clear();
+				mesh_vertices.clear();
+				transforms.clear();
+				mesh_files.clear();
+				draw_calls = 0;
+				state_changes = 0;
+				redundant_calls = 0;
+				textures_ready.clear();
+			}
+		};
+	}
+}
+
+#endif
@@ -0,0 +1,115 @@
+#ifndef FRAME_PROFILER_H_INCLUDED
+#define FRAME_PROFILER_H_INCLUDED
+
+#include <GL/glew.h>
+
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+namespace ce {
+	namespace Graphic {
+
+		// frames between the queries of a frame and the read of their results : the GPU runs that far behind without stalling
+		const std::size_t CE_PROFILER_LATENCY = 3;
+
+		// zones opened per frame, the frame zone included. The following ones are ignored
+		const std::size_t CE_PROFILER_MAX_ZONES = 64;
+
+		/// <summary>
+		///		Time spent in a zone during a frame, summed over every time the zone was opened
+		/// </summary>
+		struct ZoneTiming {
+			char const* name;
+			double cpu_ms;
+			double gpu_ms;			// 0 without timer queries : headless or unsupported
+			std::size_t calls;
+		};
+
+		/// <summary>
+		///		CPU and GPU time of the zones of a frame. Every zone puts a GL_TIMESTAMP query
+		///		at its start and its end, so the zones can nest. The queries of a frame are read
+		///		CE_PROFILER_LATENCY - 1 frames later, only once available : a frame whose results
+		///		are still missing when its queries must be reused is dropped instead of waited for.
+		///		Use it on the thread owning the context, frame() can be called from any thread.
+		/// </summary>
+		class FrameProfiler {
+			public:
+				FrameProfiler();
+				~FrameProfiler();
+
+				// not copyable
+				FrameProfiler(FrameProfiler const&) = delete;
+				FrameProfiler& operator=(FrameProfiler const&) = delete;
+
+				// movable
+				FrameProfiler(FrameProfiler&& other) noexcept;
+				FrameProfiler& operator=(FrameProfiler&& other) noexcept;
+
+				// create the queries. Without them the zones only measure the CPU
+				void init();
+
+				// open the frame zone, does nothing while a frame is open
+				void beginFrame();
+				void endFrame();
+
+				// zone names must outlive the profiler : use string literals
+				void begin(char const* name);
+				void end();
+
+				// zones of the last frame read back, the frame zone first
+				std::vector<ZoneTiming> frame() const;
+
+				// frames whose GPU results came too late
+				std::size_t dropped() const { return Dropped_; }
+
+			private:
+				using Clock = std::chrono::steady_clock;
+
+				struct ZoneRecord {
+					char const* name;
+					Clock::time_point start;
+					double cpu_ms;
+				};
+
+				struct Slot {
+					std::vector<ZoneRecord> zones;
+					bool pending;				// queries issued, results not read
+				};
+
+				bool available(std::size_t slot) const;
+				void collect(std::size_t slot);
+				void publish(Slot const& slot, std::vector<double> const& gpu_ms);
+				GLuint query(std::size_t slot, std::size_t zone, bool end) const;
+
+				Slot Slots_[CE_PROFILER_LATENCY];
+				std::vector<GLuint> Queries_;		// start and end of every zone of every slot
+				std::size_t Current_;
+				std::vector<std::size_t> Open_;		// zones of the current slot not ended, CE_PROFILER_MAX_ZONES if ignored
+				bool InFrame_;
+				std::size_t Dropped_;
+
+				mutable std::mutex Mutex_;
+				std::vector<ZoneTiming> Published_;
+		};
+
+		/// <summary>
+		///		Zone open during its scope
+		/// </summary>
+		class ProfileZone {
+			public:
+				ProfileZone(FrameProfiler& profiler, char const* name) : Profiler_{ profiler } { Profiler_.begin(name); }
+				~ProfileZone() { Profiler_.end(); }
+
+				// not copyable
+				ProfileZone(ProfileZone const&) = delete;
+				ProfileZone& operator=(ProfileZone const&) = delete;
+
+			private:
+				FrameProfiler& Profiler_;
+		};
+	}
+}
+
+#endif
@@ -0,0 +1,70 @@
+#ifndef FRUSTUM_CULLING_H_INCLUDED
+#define FRUSTUM_CULLING_H_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "utils.h"
+
+// widest instruction set the culling is compiled for. Define CE_NO_SIMD to keep the scalar loop.
+#if !defined(CE_NO_SIMD) && defined(__AVX__)
+#define CE_CULLING_AVX
+#elif !defined(CE_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define CE_CULLING_SSE
+#endif
+
+namespace ce {
+	namespace Graphic {
+
+		/// <summary>
+		///		Plane a.x + b.y + c.z + d = 0, the normal points inside the frustum
+		/// </summary>
+		struct Plane {
+			float a, b, c, d;
+		};
+
+		/// <summary>
+		///		Left, right, bottom, top, near and far planes, normalized
+		/// </summary>
+		struct Frustum {
+			Plane planes[6];
+		};
+
+		// planes of a view projection matrix, in world space when the matrix is projection * view
+		Frustum extract_frustum(glm::mat4 const& view_projection);
+
+		/// <summary>
+		///		Bounding volumes to test against a frustum, stored one array per coordinate
+		///		so several volumes are tested at once. A volume is a sphere, a box or both :
+		///		its distance to a plane is compared to the radius plus the box extent along the normal.
+		/// </summary>
+		class CullingSet {
+			public:
+				CullingSet() = default;
+
+				// half_extents is the half size of the axis aligned box around the center, zero for a sphere
+				void add(Core::fVec3 const& center, float radius, Core::fVec3 const& half_extents);
+
+				// forget the volumes, the memory is kept for the next frame
+				void clear();
+
+				// append the index, in add order, of every volume touching the frustum
+				void cull(Frustum const& frustum, std::vector<std::uint32_t>& visible) const;
+
+				std::size_t size() const { return X_.size(); }
+
+			private:
+				std::size_t cull_simd(Frustum const& frustum, std::vector<std::uint32_t>& visible) const;
+				bool inside(Frustum const& frustum, std::size_t i) const;
+
+				std::vector<float> X_, Y_, Z_;
+				std::vector<float> Radius_;
+				std::vector<float> ExtentX_, ExtentY_, ExtentZ_;
+		};
+	}
+}
+
+#endif
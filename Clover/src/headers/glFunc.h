@@ -1,89 +1,261 @@
-#ifndef RENDERER_H_INCLUDED
-#define RENDERER_H_INCLUDED
-
-#include <GL/glew.h> 
-#include <GLFW/glfw3.h>
-
-#include <vector>
-
-//#define CE_VERBOSE
-
-namespace ce {
-	namespace Graphic {
-
-        // Open GL param constants
-        const auto CE_OPENGL_MAJOR = 3;
-        const auto CE_OPENGL_MINOR = 3;
-        const auto CE_GLFW_OPENGL_PROFILE = GLFW_OPENGL_CORE_PROFILE;
-        const auto CE_GLFW_OPENGL_FORWARD_COMPAT = GL_TRUE;
-
-        using vertices = std::vector<GLfloat>;
-
-        class GLFunc {
-        public:
-            // context creation
-            static GLFWwindow*  CreateContextWindow(std::string title, int w, int h, bool set_current_context = true);
-            static void         SetContextWindow(GLFWwindow* cw);
-            static bool         WindowShouldClose(GLFWwindow* w);
-
-            // gl elements handling : VAO , VBO , VIO , NORMALS, UVS
-            static GLuint   GetVAO();
-            static void     BindVAO(GLuint vao_id);
-            static void     UnbindVao();
-
-            static GLuint   BindVBO(GLuint vao_id, vertices vertex_buffer, bool unbind_vao = false);
-
-            static void     EnableAttribute(int attrib);
-            static void     DisableAttribute(int attrib);
-            
-            // shaders 
-            static GLuint   LoadShadersFromFiles(const char* vertex_file_path, const char* fragment_file_path);
-            static GLuint   LoadStringShaders(std::string VertexShaderCode, std::string FragmentShaderCode);
-            static void     UseShader(GLuint program_id);
-            static GLuint   GetShaderMatrixID(GLuint program_id, std::string matrix_name);
-            static void     BindShaderMatrixData(GLuint matrix_id, float* data);
-
-            // draw functions
-            static void DrawArrays(GLenum mode, GLint start, GLsizei count);
-
-            // others
-            static void Terminate() {
-                if (InternalState::GLFUNC_READY) {
-                    TerminateGLFW();
-                    InternalState::GLEW_INITIALIZED = false;
-                    InternalState::GLFW_INITIALIZED = false;
-                    InternalState::CURRENT_CONTEXT_WINDOW = nullptr;
-                    InternalState::BINDED_VAO = 0;
-                    InternalState::SHADER_PROGRAM_ID = 0;
-                    InternalState::GLFUNC_READY = false;
-                }
-            }
-
-            static void ClearBuffers()
-            {
-                glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-            }
-
-        private:
-
-            // manage gl state and avoid useless gl call
-            struct InternalState {
-                static bool         GLEW_INITIALIZED;
-                static bool         GLFW_INITIALIZED;
-                static bool         GLFUNC_READY;
-                static GLFWwindow*  CURRENT_CONTEXT_WINDOW;
-                static GLuint       BINDED_VAO;
-                static GLuint       SHADER_PROGRAM_ID;
-            };
-
-            static bool vao_is_binded(GLuint vao_id);
-            static bool init_glew();
-            static bool init_glfw();
-            static void show_glfw_error(int error, const char* description);
-            static void TerminateGLFW();
-            static GLFWwindow* CreateWindow(std::string title, int w, int h);
-        };
-	}
-}
-
-#endif
+#ifndef RENDERER_H_INCLUDED
+#define RENDERER_H_INCLUDED
+
+#include <GL/glew.h> 
+#include <GLFW/glfw3.h>
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "offscreen_context.h"
+#include "program_cache.h"
+#include "shader_program.h"
+
+//#define CE_VERBOSE
+
+namespace ce {
+	namespace Graphic {
+
+        // Open GL param constants
+        const auto CE_OPENGL_MAJOR = 3;
+        const auto CE_OPENGL_MINOR = 3;
+        const auto CE_GLFW_OPENGL_PROFILE = GLFW_OPENGL_CORE_PROFILE;
+        const auto CE_GLFW_OPENGL_FORWARD_COMPAT = GL_TRUE;
+
+        using vertices = std::vector<GLfloat>;
+
+        // sizes of the state cache, bindings outside of it go straight to the driver
+        const auto CE_MAX_TEXTURE_UNITS = 16;
+        const auto CE_CACHED_TEXTURE_TARGETS = 4;      // 2D, cube map, 2D array, 3D
+        const auto CE_CACHED_BUFFER_TARGETS = 8;       // element arrays are cached per VAO
+        const auto CE_CACHED_VERTEX_ATTRIBUTES = 32;
+
+        /// <summary>
+        ///     GL calls issued and skipped by the state cache since the last reset
+        /// </summary>
+        struct GLStateStats {
+            std::size_t calls;      // state changes sent to the driver
+            std::size_t skipped;    // redundant state changes, the cache already matched
+        };
+
+        // no asynchronous compilation to wait for
+        const std::size_t CE_NO_SHADER_REQUEST = static_cast<std::size_t>(-1);
+
+        class GLFunc {
+        public:
+            // context creation
+            static GLFWwindow*  CreateContextWindow(std::string title, int w, int h, bool set_current_context = true);
+            static void         SetContextWindow(GLFWwindow* cw);
+            static void         ReleaseContext();   // before making the context current on another thread
+
+            // context without window nor display, needs CE_USE_EGL. It has no default framebuffer : draw into a RenderTarget
+            static bool         CreateOffscreenContext();
+            static void         SetOffscreenContext();
+            static bool         WindowShouldClose(GLFWwindow* w);
+            static bool         IsReady() { return InternalState::GLFUNC_READY; }
+
+            // every state change below goes through the cache : setting the current value again costs no driver call
+            static GLStateStats const& StateStats() { return InternalState::STATE_STATS; }
+            static void     ResetStateStats() { InternalState::STATE_STATS = GLStateStats{}; }
+
+            // gl elements handling : VAO , VBO , VIO , NORMALS, UVS
+            static GLuint   GetVAO();
+            static void     DeleteVAO(GLuint vao_id);
+            static void     BindVAO(GLuint vao_id);
+            static void     UnbindVao();
+
+            // creates a new buffer on each call, the caller owns it. Prefer BufferManager.
+            static GLuint   BindVBO(GLuint vao_id, vertices vertex_buffer, bool unbind_vao = false);
+
+            // buffer objects
+            static GLuint   GenBuffer();
+            static void     DeleteBuffer(GLuint buffer_id);
+            static void     BindBuffer(GLenum target, GLuint buffer_id);
+            static void     BufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage);
+            static void     BufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data);
+            static void     VertexAttribPointer(GLuint attrib, GLint size, GLenum type, GLsizei stride, GLintptr offset);
+            static void     VertexAttribDivisor(GLuint attrib, GLuint divisor);
+
+            // enabled attributes are tracked per VAO, like GL does
+            static void     EnableAttribute(int attrib);
+            static void     DisableAttribute(int attrib);
+
+            // textures and samplers, per texture unit
+            static GLuint   GenTexture();
+            static void     DeleteTexture(GLuint texture_id);
+            static void     ActiveTexture(GLuint unit);
+            static void     BindTexture(GLuint unit, GLenum target, GLuint texture_id);
+            static void     BindSampler(GLuint unit, GLuint sampler_id);
+
+            // framebuffers, GL_FRAMEBUFFER binds both the read and the draw framebuffer
+            static GLuint   GenFramebuffer();
+            static void     DeleteFramebuffer(GLuint framebuffer_id);
+            static void     BindFramebuffer(GLenum target, GLuint framebuffer_id);
+
+            // fixed function state
+            static void     SetCapability(GLenum capability, bool enabled);   // GL_BLEND, GL_DEPTH_TEST, GL_CULL_FACE, GL_SCISSOR_TEST
+            static void     BlendFunc(GLenum source, GLenum destination);
+            static void     DepthFunc(GLenum func);
+            static void     DepthMask(bool write);
+            static void     CullFace(GLenum face);
+            static void     Scissor(GLint x, GLint y, GLsizei width, GLsizei height);
+            static void     Viewport(GLint x, GLint y, GLsizei width, GLsizei height);
+            static void     ClearColor(GLfloat r, GLfloat g, GLfloat b, GLfloat a);
+            
+            // shaders 
+            static GLuint   LoadShadersFromFiles(const char* vertex_file_path, const char* fragment_file_path);
+            // Defines is inserted after the #version line of both stages
+            static GLuint   LoadStringShaders(std::string VertexShaderCode, std::string FragmentShaderCode, std::string const& Defines = "");
+            static void     UseShader(GLuint program_id);
+            static void     DeleteProgram(GLuint program_id);
+
+            // linked programs are looked up in the cache first and stored after linking, null to disable
+            static void     SetProgramCache(ProgramCache* cache);
+
+            // asynchronous compilation : a request is ready after some PollShaders calls, draw with a fallback meanwhile.
+            // With KHR_parallel_shader_compile the driver compiles on its threads and the status is polled without blocking.
+            // GetRequestProgram hands a finished request over and forgets it : the program of a failed one is deleted.
+            using ShaderRequest = std::size_t;
+            enum class ShaderStatus { PENDING, READY, FAILED };
+
+            static ShaderRequest CompileShadersAsync(std::string VertexShaderCode, std::string FragmentShaderCode, std::string const& Defines = "");
+            static void     PollShaders();      // once per frame
+            static void     FinishShaders();    // block until every request is done
+            static ShaderStatus GetShaderStatus(ShaderRequest request);
+            static GLuint   GetRequestProgram(ShaderRequest request, GLuint fallback = 0);
+            static GLuint   GetRequestProgramName(ShaderRequest request);  // the program object exists before it links, sort keys can use it
+
+            // reflection done at link time, null if the program did not link. Prefer its typed uniform handles
+            // to GetShaderMatrixID, which asks the driver by name on every call and bypasses the value cache.
+            static ShaderProgram* GetProgram(GLuint program_id);
+            static GLuint   GetShaderMatrixID(GLuint program_id, std::string matrix_name);
+            static void     BindShaderMatrixData(GLuint matrix_id, float* data);
+
+            // draw functions
+            static void DrawArrays(GLenum mode, GLint start, GLsizei count);
+            static void DrawArraysInstanced(GLenum mode, GLint start, GLsizei count, GLsizei instances);
+
+            // indexed draws, the index buffer is the one recorded in the bound VAO. offset is in bytes
+            static void DrawElements(GLenum mode, GLsizei count, GLenum index_type, GLintptr offset);
+            static void DrawElementsInstanced(GLenum mode, GLsizei count, GLenum index_type, GLintptr offset, GLsizei instances);
+
+            // others
+            static void Terminate() {
+                if (InternalState::GLFUNC_READY) {
+                    TerminateGLFW();
+                    InternalState::GLEW_INITIALIZED = false;
+                    InternalState::GLFW_INITIALIZED = false;
+                    InternalState::CURRENT_CONTEXT_WINDOW = nullptr;
+                    InternalState::CACHED_CONTEXT_WINDOW = nullptr;
+                    InternalState::OFFSCREEN_CONTEXT.reset();
+                    InternalState::OFFSCREEN_CURRENT = false;
+                    reset_state_cache();
+                    InternalState::PROGRAMS.clear();
+                    InternalState::PROGRAM_CACHE = nullptr;
+                    InternalState::SHADER_REQUESTS.clear();
+                    InternalState::PARALLEL_COMPILE = false;
+                    InternalState::GLFUNC_READY = false;
+                }
+            }
+
+            static void ClearBuffers()
+            {
+                glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+            }
+
+        private:
+
+            // program between glLinkProgram and its status query. vertex and fragment are 0 when it came from the cache
+            struct ProgramBuild {
+                GLuint          program;
+                GLuint          vertex;
+                GLuint          fragment;
+                std::uint64_t   key;
+                bool            cached;
+            };
+
+            struct ShaderRequestState {
+                ProgramBuild    build;
+                ShaderStatus    status;
+                std::size_t     poll;       // PollShaders calls before the submission
+            };
+
+            // state owned by a VAO
+            struct VertexArrayState {
+                GLuint          element_buffer;
+                std::uint32_t   enabled_attributes;     // one bit per attribute
+            };
+
+            // fixed function state, GL defaults for a new context. -1 : unknown until set once
+            struct RasterState {
+                bool            capabilities[4];        // blend, depth test, cull face, scissor test
+                GLenum          blend_source;
+                GLenum          blend_destination;
+                GLenum          depth_func;
+                bool            depth_mask;
+                GLenum          cull_face;
+                GLint           scissor[4];
+                GLint           viewport[4];
+                GLfloat         clear_color[4];
+            };
+
+            // manage gl state and avoid useless gl call
+            struct InternalState {
+                static bool         GLEW_INITIALIZED;
+                static bool         GLFW_INITIALIZED;
+                static bool         GLFUNC_READY;
+                static GLFWwindow*  CURRENT_CONTEXT_WINDOW;
+                static GLFWwindow*  CACHED_CONTEXT_WINDOW;      // context described by the cache below
+                static std::unique_ptr<OffscreenContext> OFFSCREEN_CONTEXT;
+                static bool         OFFSCREEN_CURRENT;
+                static GLuint       BINDED_VAO;
+                static GLuint       SHADER_PROGRAM_ID;
+                static GLuint       BOUND_BUFFERS[CE_CACHED_BUFFER_TARGETS];
+                static GLuint       ACTIVE_TEXTURE_UNIT;
+                static GLuint       BOUND_TEXTURES[CE_MAX_TEXTURE_UNITS][CE_CACHED_TEXTURE_TARGETS];
+                static GLuint       BOUND_SAMPLERS[CE_MAX_TEXTURE_UNITS];
+                static GLuint       READ_FRAMEBUFFER;
+                static GLuint       DRAW_FRAMEBUFFER;
+                static RasterState  RASTER;
+                static std::map<GLuint, VertexArrayState> VERTEX_ARRAYS;
+                static GLStateStats STATE_STATS;
+                static std::map<GLuint, std::unique_ptr<ShaderProgram>> PROGRAMS;
+                static ProgramCache* PROGRAM_CACHE;
+                static std::map<ShaderRequest, ShaderRequestState> SHADER_REQUESTS;   // pending or not handed over yet
+                static ShaderRequest NEXT_SHADER_REQUEST;
+                static std::size_t  SHADER_POLLS;
+                static bool         PARALLEL_COMPILE;
+            };
+
+            // count the call and tell whether the cache makes it redundant
+            static bool skip_call(bool cached) {
+                if (cached) ++InternalState::STATE_STATS.skipped;
+                else ++InternalState::STATE_STATS.calls;
+                return cached;
+            }
+
+            static void reset_state_cache();
+            static std::string inject_defines(std::string const& code, std::string const& defines);
+            static std::uint64_t program_key(std::string const& vertex_code, std::string const& fragment_code);
+            static GLuint load_program_binary(std::uint64_t key);
+            static ProgramBuild begin_program(std::string const& vertex_code, std::string const& fragment_code);
+            static bool end_program(ProgramBuild const& build);
+            static void finish_request(ShaderRequestState& request);
+            static void store_program_binary(std::uint64_t key, GLuint program_id);
+            static int  buffer_slot(GLenum target);
+            static int  texture_slot(GLenum target);
+            static int  capability_slot(GLenum capability);
+            static bool vao_is_binded(GLuint vao_id);
+            static bool init_glew();
+            static bool init_glfw();
+            static void show_glfw_error(int error, const char* description);
+            static void TerminateGLFW();
+            static GLFWwindow* CreateWindow(std::string title, int w, int h);
+        };
+	}
+}
+
+#endif
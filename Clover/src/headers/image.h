@@ -0,0 +1,33 @@
+#ifndef IMAGE_H_INCLUDED
+#define IMAGE_H_INCLUDED
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace ce {
+	namespace Graphic {
+
+		// widest and tallest picture decoded, larger headers are taken for corrupted files
+		const int CE_IMAGE_MAX_SIZE = 16384;
+
+		/// <summary>
+		///		Decoded picture, 4 bytes per pixel in RGBA order.
+		///		Rows go from the bottom to the top, as glTexImage2D expects them.
+		/// </summary>
+		struct Image {
+			int width = 0;
+			int height = 0;
+			std::vector<unsigned char> pixels;
+		};
+
+		// uncompressed 24 or 32 bit BMP and binary PPM (P6), false when the format is not supported
+		bool decode_image(unsigned char const* data, std::size_t size, Image& image);
+		bool load_image(std::string const& path, Image& image);
+
+		// binary PPM, the alpha is dropped
+		bool save_image(std::string const& path, Image const& image);
+	}
+}
+
+#endif
@@ -0,0 +1,101 @@
+#ifndef INPUT_RECORD_H_INCLUDED
+#define INPUT_RECORD_H_INCLUDED
+
+#include <cstdint>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace ce {
+	namespace Event {
+
+		struct RawEvent;
+		class glEventSystem;
+
+		// file header, bump the version when the record layout changes
+		const char CE_INPUT_RECORD_MAGIC[8] = { 'C', 'L', 'V', 'R', 'I', 'N', 'P', '1' };
+
+		/// <summary>
+		///		Feeds events to an event system in place of glfwPollEvents
+		/// </summary>
+		class EventSource {
+			public:
+				virtual ~EventSource() {}
+
+				// queue the events of the next frame with glEventSystem::inject
+				virtual void poll(glEventSystem& es) = 0;
+		};
+
+		/// <summary>
+		///		Write the dispatched events to a binary file, frame by frame.
+		///		Each frame is an event count followed by the events, each event only
+		///		stores the fields its type uses, in the machine byte order.
+		/// </summary>
+		class InputRecorder {
+			public:
+				InputRecorder(std::string const& path);
+
+				// not copyable
+				InputRecorder(InputRecorder const&) = delete;
+				InputRecorder& operator=(InputRecorder const&) = delete;
+
+				bool isOpen() const { return File_.is_open(); }
+
+				// called once per dispatch with the events of the frame
+				void record(std::vector<RawEvent> const& frame_events);
+
+				std::size_t frames() const { return Frame_; }
+
+			private:
+				std::ofstream File_;
+				std::vector<char> Buffer_;
+				std::uint32_t Frame_;
+		};
+
+		/// <summary>
+		///		Replay a recorded file, the events recorded at frame N are queued at the Nth poll.
+		/// </summary>
+		class InputReplay : public EventSource {
+			public:
+				InputReplay(std::string const& path);
+
+				bool isOpen() const { return Loaded_; }
+
+				// every recorded frame has been replayed
+				bool done() const { return Frame_ >= FrameCount_; }
+
+				void poll(glEventSystem& es);
+
+				std::size_t frames() const { return FrameCount_; }
+
+			private:
+				std::vector<char> Data_;
+				std::size_t Cursor_;
+				std::uint32_t Frame_;
+				std::uint32_t FrameCount_;
+				bool Loaded_;
+		};
+
+		/// <summary>
+		///		Generate a random but reproducible input stream : key presses and releases,
+		///		mouse motion and clicks, for windowless simulation and load tests.
+		/// </summary>
+		class SyntheticEventSource : public EventSource {
+			public:
+				SyntheticEventSource(std::uint32_t seed, double width = 800.0, double height = 600.0);
+
+				void poll(glEventSystem& es);
+
+			private:
+				std::mt19937 Random_;
+				double Width_;
+				double Height_;
+				double Time_;
+				double MouseX_;
+				double MouseY_;
+		};
+	}
+}
+
+#endif
@@ -0,0 +1,70 @@
+#ifndef INPUT_STATE_H_INCLUDED
+#define INPUT_STATE_H_INCLUDED
+
+#include <bitset>
+
+#include "event_keys.h"
+
+namespace ce {
+	namespace Event {
+
+		struct RawEvent;
+
+		// every key and button code glfw may report
+		const std::size_t CE_KEY_COUNT = GLFW_KEY_LAST + 1;
+		const std::size_t CE_MOUSE_BUTTON_COUNT = GLFW_MOUSE_BUTTON_LAST + 1;
+
+		/// <summary>
+		///		Keyboard and mouse state of a frame, built by the event system from the dispatched events.
+		///		A published state is never modified, it can be read from any thread.
+		/// </summary>
+		class InputState {
+			public:
+				InputState();
+
+				// key is held down
+				bool Down(ceKbKeyType key) const { return valid_key(key) && Down_[key]; }
+				// key went down during the frame
+				bool Pressed(ceKbKeyType key) const { return valid_key(key) && Pressed_[key]; }
+				// key went up during the frame
+				bool Released(ceKbKeyType key) const { return valid_key(key) && Released_[key]; }
+
+				bool MouseDown(ceMouseButtonType button) const { return valid_button(button) && MouseDown_[button]; }
+				bool MousePressed(ceMouseButtonType button) const { return valid_button(button) && MousePressed_[button]; }
+				bool MouseReleased(ceMouseButtonType button) const { return valid_button(button) && MouseReleased_[button]; }
+
+				double MouseX() const { return MouseX_; }
+				double MouseY() const { return MouseY_; }
+				double MouseDX() const { return MouseDX_; }
+				double MouseDY() const { return MouseDY_; }
+
+				// number of the dispatch that built this state
+				std::size_t Frame() const { return Frame_; }
+
+				// start a new frame : keep what is held, forget the transitions
+				void beginFrame();
+				void apply(RawEvent const& event);
+
+			private:
+				static bool valid_key(ceKbKeyType key) { return key >= 0 && static_cast<std::size_t>(key) < CE_KEY_COUNT; }
+				static bool valid_button(ceMouseButtonType button) { return button >= 0 && static_cast<std::size_t>(button) < CE_MOUSE_BUTTON_COUNT; }
+
+				std::bitset<CE_KEY_COUNT> Down_;
+				std::bitset<CE_KEY_COUNT> Pressed_;
+				std::bitset<CE_KEY_COUNT> Released_;
+
+				std::bitset<CE_MOUSE_BUTTON_COUNT> MouseDown_;
+				std::bitset<CE_MOUSE_BUTTON_COUNT> MousePressed_;
+				std::bitset<CE_MOUSE_BUTTON_COUNT> MouseReleased_;
+
+				double MouseX_;
+				double MouseY_;
+				double MouseDX_;
+				double MouseDY_;
+
+				std::size_t Frame_;
+		};
+	}
+}
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef JOB_SYSTEM_H_INCLUDED
+#define JOB_SYSTEM_H_INCLUDED
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ce {
+	namespace Core {
+
+		using Job = std::function<void()>;
+
+		/// <summary>
+		///		Small pool of worker threads running jobs in submission order.
+		/// </summary>
+		class JobSystem {
+			public:
+
+				// 0 worker means one worker per hardware thread minus the main thread
+				JobSystem(std::size_t workers = 0);
+				~JobSystem();
+
+				// not copyable
+				JobSystem(JobSystem const&) = delete;
+				JobSystem& operator=(JobSystem const&) = delete;
+
+				// not movable, workers keep a pointer on the system
+				JobSystem(JobSystem&&) = delete;
+				JobSystem& operator=(JobSystem&&) = delete;
+
+				void submit(Job job);
+				void wait();
+
+				std::size_t workerCount() const { return Workers_.size(); }
+
+			private:
+				void work();
+
+				std::vector<std::thread> Workers_;
+				std::deque<Job> Jobs_;
+				std::mutex Mutex_;
+				std::condition_variable JobReady_;
+				std::condition_variable Idle_;
+				std::size_t Running_;
+				bool Stop_;
+		};
+	}
+}
+
+#endif
@@ -0,0 +1,45 @@
+#ifndef MAPPED_FILE_H_INCLUDED
+#define MAPPED_FILE_H_INCLUDED
+
+#include <cstddef>
+#include <string>
+
+namespace ce {
+	namespace Core {
+
+		/// <summary>
+		///		Read only view of a whole file mapped in memory. The pages are loaded by the OS
+		///		when first touched : opening is cheap and nothing is copied.
+		/// </summary>
+		class MappedFile {
+			public:
+				MappedFile();
+				MappedFile(std::string const& path);
+				~MappedFile();
+
+				// not copyable
+				MappedFile(MappedFile const&) = delete;
+				MappedFile& operator=(MappedFile const&) = delete;
+
+				// movable
+				MappedFile(MappedFile&& other) noexcept;
+				MappedFile& operator=(MappedFile&& other) noexcept;
+
+				bool isOpen() const { return Data_ != nullptr; }
+				unsigned char const* data() const { return Data_; }
+				std::size_t size() const { return Size_; }
+
+				void close();
+
+			private:
+				unsigned char const* Data_;
+				std::size_t Size_;
+#ifdef _WIN32
+				void* File_;
+				void* Mapping_;
+#endif
+		};
+	}
+}
+
+#endif
@@ -0,0 +1,95 @@
+#ifndef MESH_H_INCLUDED
+#define MESH_H_INCLUDED
+
+#include <GL/glew.h>
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <vector>
+
+#include "buffer_manager.h"
+#include "colors.h"
+#include "utils.h"
+
+namespace ce {
+	namespace Graphic {
+
+		using MeshId = std::size_t;
+		const MeshId CE_INVALID_MESH = static_cast<MeshId>(-1);
+
+		// per-instance attributes : the model matrix takes 4 locations, one per column
+		const GLuint CE_INSTANCE_MODEL_LOCATION = 1;
+		const GLuint CE_INSTANCE_COLOR_LOCATION = 5;
+
+		/// <summary>
+		///		What the instance buffer holds for each drawn copy of a mesh
+		/// </summary>
+		struct InstanceData {
+			glm::mat4 model;
+			color<float> tint;
+		};
+
+		/// <summary>
+		///		Geometry to upload, pointing into memory owned by the caller : a vector or a mapped file
+		/// </summary>
+		struct MeshData {
+			Core::fVec3 const* positions;
+			std::size_t vertex_count;
+			void const* indices;	// null for a triangle list
+			std::size_t index_count;
+			GLenum index_type;		// GL_UNSIGNED_SHORT or GL_UNSIGNED_INT
+		};
+
+		/// <summary>
+		///		Geometry uploaded once and drawn many times
+		/// </summary>
+		struct Mesh {
+			GLuint vao;				// 0 for headless meshes
+			BufferHandle vertices;
+			GLsizei vertex_count;
+			BufferHandle indices;	// CE_INVALID_BUFFER when not indexed
+			GLsizei index_count;
+			GLenum index_type;		// 0 when not indexed
+
+			// vertices read by one draw of the mesh
+			GLsizei element_count() const { return index_type != 0 ? index_count : vertex_count; }
+		};
+
+		/// <summary>
+		///		Keep the meshes and their VAO. The vertex data lives in a BufferManager,
+		///		the instance attributes of every VAO read from a shared instance buffer.
+		/// </summary>
+		class MeshRegistry {
+			public:
+				MeshRegistry();
+				~MeshRegistry();
+
+				// not copyable
+				MeshRegistry(MeshRegistry const&) = delete;
+				MeshRegistry& operator=(MeshRegistry const&) = delete;
+
+				// movable
+				MeshRegistry(MeshRegistry&& other) noexcept;
+				MeshRegistry& operator=(MeshRegistry&& other) noexcept;
+
+				// buffers is null for headless renderers : only the counts are kept
+				MeshId add(std::vector<Core::fVec3> const& positions, BufferManager* buffers);
+				MeshId add(MeshData const& data, BufferManager* buffers);
+
+				// bind the mesh VAO with its instance attributes reading from the given byte offset
+				void bindInstances(MeshId mesh, GLuint instance_buffer, GLintptr offset) const;
+
+				void clear();
+
+				Mesh const& get(MeshId mesh) const { return Meshes_[mesh]; }
+				bool valid(MeshId mesh) const { return mesh < Meshes_.size(); }
+				std::size_t size() const { return Meshes_.size(); }
+
+			private:
+				std::vector<Mesh> Meshes_;
+		};
+	}
+}
+
+#endif
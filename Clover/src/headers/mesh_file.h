@@ -0,0 +1,51 @@
+#ifndef MESH_FILE_H_INCLUDED
+#define MESH_FILE_H_INCLUDED
+
+#include <cstdint>
+#include <string>
+
+#include "mapped_file.h"
+#include "mesh.h"
+
+namespace ce {
+	namespace Graphic {
+
+		// file header, bump the version when the layout changes
+		const char CE_MESH_FILE_MAGIC[8] = { 'C', 'L', 'V', 'R', 'M', 'S', 'H', '1' };
+
+		/// <summary>
+		///		Baked mesh layout, little endian : this header, the positions as 3 floats
+		///		per vertex, then the indices. Everything is ready to be copied to the GPU.
+		/// </summary>
+		struct MeshFileHeader {
+			char magic[8];
+			std::uint32_t vertex_count;
+			std::uint32_t index_count;
+			std::uint32_t index_size;	// 2 or 4 bytes
+			std::uint32_t reserved;
+		};
+
+		/// <summary>
+		///		Baked mesh mapped in memory. Opening only checks the header :
+		///		the upload reads the vertices and indices straight from the mapping.
+		/// </summary>
+		class MeshFile {
+			public:
+				MeshFile(std::string const& path);
+
+				bool isOpen() const { return Valid_; }
+
+				// views into the mapping, valid while the file is alive
+				MeshData data() const;
+
+			private:
+				Core::MappedFile File_;
+				bool Valid_;
+		};
+
+		// offline conversion of the positions and faces of an OBJ file, polygons are triangulated
+		bool bake_obj(std::string const& obj_path, std::string const& mesh_path);
+	}
+}
+
+#endif
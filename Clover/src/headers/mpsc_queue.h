@@ -0,0 +1,104 @@
+#ifndef MPSC_QUEUE_H_INCLUDED
+#define MPSC_QUEUE_H_INCLUDED
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+#include "ring_buffer.h"
+
+namespace ce {
+	namespace Core {
+
+		/// <summary>
+		///		Fixed size lock-free queue for any number of producer threads and one consumer thread.
+		///		Each producer claims slots in increasing order, so the elements pushed by one thread
+		///		are popped in the order it pushed them.
+		/// </summary>
+		/// <typeparam name="T">Element type, copied in and out</typeparam>
+		/// <typeparam name="N">Capacity, must be a power of two</typeparam>
+		template<class T, std::size_t N>
+		class MpscQueue {
+			static_assert(N >= 2 && (N & (N - 1)) == 0, "MpscQueue capacity must be a power of two.");
+
+			public:
+				MpscQueue() : Cells_{ std::make_unique<Cell[]>(N) }, Head_{ 0 }, Tail_{ 0 }
+				{
+					// a cell is free for position p when its sequence is p
+					for (std::size_t i = 0; i < N; ++i)
+						Cells_[i].sequence.store(i, std::memory_order_relaxed);
+				}
+
+				// not copyable
+				MpscQueue(MpscQueue const&) = delete;
+				MpscQueue& operator=(MpscQueue const&) = delete;
+
+				/// <summary>
+				///		Producer side, from any thread. Fails when the queue is full.
+				/// </summary>
+				bool push(T const& value)
+				{
+					auto pos = Tail_.load(std::memory_order_relaxed);
+					Cell* cell;
+
+					for (;;)
+					{
+						cell = &Cells_[pos & (N - 1)];
+						auto const seq = cell->sequence.load(std::memory_order_acquire);
+						auto const diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+
+						if (diff == 0)
+						{
+							// the cell is free, claim the position
+							if (Tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+								break;
+						}
+						else if (diff < 0)
+						{
+							return false; // the consumer did not release the cell yet : full
+						}
+						else
+						{
+							pos = Tail_.load(std::memory_order_relaxed);
+						}
+					}
+
+					cell->value = value;
+					cell->sequence.store(pos + 1, std::memory_order_release);
+					return true;
+				}
+
+				/// <summary>
+				///		Consumer side. Fails when the queue is empty or when the oldest
+				///		claimed cell is still being written by its producer.
+				/// </summary>
+				bool pop(T& value)
+				{
+					auto const pos = Head_;
+					auto& cell = Cells_[pos & (N - 1)];
+
+					if (cell.sequence.load(std::memory_order_acquire) != pos + 1)
+						return false;
+
+					value = cell.value;
+					cell.sequence.store(pos + N, std::memory_order_release);
+					Head_ = pos + 1;
+					return true;
+				}
+
+				static constexpr std::size_t capacity() { return N; }
+
+			private:
+				struct Cell {
+					std::atomic<std::size_t> sequence;
+					T value;
+				};
+
+				std::unique_ptr<Cell[]> Cells_;
+				alignas(CE_CACHE_LINE) std::size_t Head_; // consumer only
+				alignas(CE_CACHE_LINE) std::atomic<std::size_t> Tail_;
+		};
+	}
+}
+
+#endif
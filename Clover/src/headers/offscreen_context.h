@@ -0,0 +1,44 @@
+#ifndef OFFSCREEN_CONTEXT_H_INCLUDED
+#define OFFSCREEN_CONTEXT_H_INCLUDED
+
+namespace ce {
+	namespace Graphic {
+
+		/// <summary>
+		///		GL context without window nor display, made with EGL. Mesa's surfaceless platform
+		///		is tried first so it runs on llvmpipe on a build machine without X server.
+		///		The context has no default framebuffer : render into a RenderTarget.
+		///		Only available when built with CE_USE_EGL, create fails otherwise.
+		/// </summary>
+		class OffscreenContext {
+			public:
+				OffscreenContext();
+				~OffscreenContext();
+
+				// not copyable
+				OffscreenContext(OffscreenContext const&) = delete;
+				OffscreenContext& operator=(OffscreenContext const&) = delete;
+
+				// not movable, GLFunc owns the only one
+				OffscreenContext(OffscreenContext&&) = delete;
+				OffscreenContext& operator=(OffscreenContext&&) = delete;
+
+				// core profile context of the given version, false with an error message on failure
+				bool create(int major, int minor);
+
+				bool makeCurrent();
+				bool release();
+				bool isValid() const { return Context_ != nullptr; }
+
+			private:
+				void destroy();
+
+				// EGL handles, kept opaque so the EGL headers stay out of glew.h's way
+				void* Display_;
+				void* Context_;
+				void* Surface_;		// null with EGL_KHR_surfaceless_context, a 1x1 pbuffer otherwise
+		};
+	}
+}
+
+#endif
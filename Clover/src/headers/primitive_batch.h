@@ -0,0 +1,64 @@
+#ifndef PRIMITIVE_BATCH_H_INCLUDED
+#define PRIMITIVE_BATCH_H_INCLUDED
+
+#include <cstddef>
+#include <vector>
+
+#include "colors.h"
+#include "utils.h"
+
+namespace ce {
+	namespace Graphic {
+
+		/// <summary>
+		///		Vertex layout of the batched primitives : position then color
+		/// </summary>
+		struct BatchVertex {
+			float x, y, z;
+			float r, g, b, a;
+		};
+
+		/// <summary>
+		///		GL primitive a batch is drawn with, changing it ends the batch
+		/// </summary>
+		enum class BatchPrimitive {
+			TRIANGLES,
+			LINES
+		};
+
+		// vertices held before a batch is flushed, about 7 MB of vertex data
+		const std::size_t CE_BATCH_MAX_VERTICES = 1 << 18;
+
+		/// <summary>
+		///		CPU side vertex stream. Primitives of the same type are appended one after
+		///		the other and drawn together by a single call when the batch is flushed.
+		/// </summary>
+		class PrimitiveBatch {
+			public:
+				PrimitiveBatch();
+
+				// true when the vertices can not be appended to the current batch : flush it first
+				bool needsFlush(BatchPrimitive primitive, std::size_t vertex_count) const;
+
+				void triangle(Core::fVec3 const& p1, Core::fVec3 const& p2, Core::fVec3 const& p3, color<float> const& c);
+				void quad(Core::fVec3 const& p1, Core::fVec3 const& p2, Core::fVec3 const& p3, Core::fVec3 const& p4, color<float> const& c);
+				void line(Core::fVec3 const& p1, Core::fVec3 const& p2, color<float> const& c);
+
+				// forget the vertices, the capacity is kept for the next batch
+				void clear();
+
+				bool empty() const { return Vertices_.empty(); }
+				BatchPrimitive primitive() const { return Primitive_; }
+				std::vector<BatchVertex> const& vertices() const { return Vertices_; }
+
+			private:
+				void begin(BatchPrimitive primitive);
+				void push(Core::fVec3 const& p, color<float> const& c);
+
+				std::vector<BatchVertex> Vertices_;
+				BatchPrimitive Primitive_;
+		};
+	}
+}
+
+#endif
@@ -0,0 +1,109 @@
+#ifndef PROGRAM_CACHE_H_INCLUDED
+#define PROGRAM_CACHE_H_INCLUDED
+
+#include <GL/glew.h>
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "job_system.h"
+
+namespace ce {
+	namespace Graphic {
+
+		// cache file header, bump the version when the layout changes
+		const char CE_PROGRAM_CACHE_MAGIC[8] = { 'C', 'L', 'V', 'R', 'P', 'R', 'G', '1' };
+
+		const std::uint64_t CE_FNV_OFFSET_BASIS = 0xcbf29ce484222325ull;
+		const std::uint64_t CE_FNV_PRIME = 0x100000001b3ull;
+
+		/// <summary>
+		///		FNV-1a hash, chain the calls by passing the previous hash as seed
+		/// </summary>
+		inline std::uint64_t hash_fnv1a(void const* data, std::size_t size, std::uint64_t seed = CE_FNV_OFFSET_BASIS)
+		{
+			auto bytes = static_cast<unsigned char const*>(data);
+			auto hash = seed;
+
+			for (std::size_t i = 0; i < size; ++i)
+			{
+				hash ^= bytes[i];
+				hash *= CE_FNV_PRIME;
+			}
+
+			return hash;
+		}
+
+		/// <summary>
+		///		Linked program binaries on disk, one file per key. The key hashes everything
+		///		the binary depends on : sources, defines and driver, so a driver update
+		///		misses the cache instead of loading a rejected binary.
+		/// </summary>
+		class ProgramCache {
+			public:
+				// jobs is null to read and write on the calling thread
+				ProgramCache(std::string directory, Core::JobSystem* jobs = nullptr);
+
+				// wait for the files being read or written
+				~ProgramCache();
+
+				// not copyable
+				ProgramCache(ProgramCache const&) = delete;
+				ProgramCache& operator=(ProgramCache const&) = delete;
+
+				// not movable, the jobs keep a pointer on the cache
+				ProgramCache(ProgramCache&&) = delete;
+				ProgramCache& operator=(ProgramCache&&) = delete;
+
+				// read every cached binary in the background, the lookups then do no I/O
+				void warm();
+
+				// false when the key is not cached
+				bool find(std::uint64_t key, GLenum& format, std::vector<char>& binary);
+
+				// keep a binary, written to disk in the background
+				void store(std::uint64_t key, GLenum format, std::vector<char> binary);
+
+				// forget a binary the driver rejected
+				void erase(std::uint64_t key);
+
+				std::size_t hits() const { return Hits_; }
+				std::size_t misses() const { return Misses_; }
+
+			private:
+				struct Entry {
+					GLenum format;
+					std::vector<char> binary;
+				};
+
+				std::string path(std::uint64_t key) const;
+				bool read(std::string const& file, Entry& entry) const;
+				void write(std::uint64_t key, std::uint64_t version, Entry const& entry);
+				void run(Core::Job job);
+
+				std::string Directory_;
+				Core::JobSystem* Jobs_;
+
+				std::mutex Mutex_;
+				std::condition_variable Done_;
+				std::map<std::uint64_t, Entry> Entries_;
+				std::size_t Pending_;		// jobs not finished
+				bool Warming_;
+
+				// a write only lands if it is the latest store of its key, erase cancels the pending ones
+				std::mutex FileMutex_;		// held around the file writes and removals, taken before Mutex_
+				std::map<std::uint64_t, std::uint64_t> Versions_;
+				std::uint64_t NextVersion_;
+
+				std::size_t Hits_;
+				std::size_t Misses_;
+		};
+	}
+}
+
+#endif
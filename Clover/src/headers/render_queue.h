@@ -0,0 +1,109 @@
+#ifndef RENDER_QUEUE_H_INCLUDED
+#define RENDER_QUEUE_H_INCLUDED
+
+#include <GL/glew.h>
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "mesh.h"
+#include "shader_program.h"
+
+namespace ce {
+	namespace Graphic {
+
+		using SortKey = std::uint64_t;
+
+		// bit fields of a sort key, from the most significant : the first fields change the least often
+		const unsigned CE_KEY_LAYER_BITS = 8;
+		const unsigned CE_KEY_PROGRAM_BITS = 12;
+		const unsigned CE_KEY_MATERIAL_BITS = 12;
+		const unsigned CE_KEY_VAO_BITS = 12;
+		const unsigned CE_KEY_DEPTH_BITS = 20;
+
+		const std::uint32_t CE_NO_TRANSFORM = static_cast<std::uint32_t>(-1);
+
+		/// <summary>
+		///		Pack the draw state in a key. Sorting the keys groups the draws of a layer
+		///		by program, then material, then VAO, and orders them front to back.
+		///		Ids wider than their field are truncated : it only costs some grouping, never correctness.
+		/// </summary>
+		/// <param name="depth">Normalized view depth, 0 is the nearest</param>
+		SortKey make_sort_key(std::uint32_t layer, GLuint program, std::uint32_t material, GLuint vao, float depth);
+
+		/// <summary>
+		///		One draw call and the state it needs
+		/// </summary>
+		struct RenderCommand {
+			SortKey key;
+			ShaderProgram* shader;				// null for headless renderers
+			UniformHandle<glm::mat4> transform;	// receives the transform, if any
+			std::uint32_t transform_index;		// in the queue transforms, CE_NO_TRANSFORM if none
+			GLuint vao;
+			GLenum mode;
+			GLint first;
+			GLsizei count;						// vertices, or indices when index_type is set
+			GLenum index_type;					// 0 for array draws, else the type of the VAO element buffer
+			GLsizei instances;					// 0 when not instanced
+			MeshId mesh;						// instanced draws : mesh whose instance attributes are set
+			GLintptr instance_offset;			// instanced draws : first instance in the stream buffer
+		};
+
+		/// <summary>
+		///		Draws of a frame, submitted in any order and executed sorted by key.
+		///		The sort is a stable radix sort : draws with equal keys keep their submission order.
+		/// </summary>
+		class RenderQueue {
+			public:
+				RenderQueue();
+
+				// not copyable
+				RenderQueue(RenderQueue const&) = delete;
+				RenderQueue& operator=(RenderQueue const&) = delete;
+
+				// movable
+				RenderQueue(RenderQueue&& other) noexcept = default;
+				RenderQueue& operator=(RenderQueue&& other) noexcept = default;
+
+				void submit(RenderCommand const& command) { Commands_.push_back(command); }
+
+				// store a transform for the commands of this frame
+				std::uint32_t pushTransform(glm::mat4 const& transform);
+				glm::mat4 const& transform(std::uint32_t index) const { return Transforms_[index]; }
+
+				void sort();
+
+				/// <summary>
+				///		Call f(command) on every command in key order, sort() must be called first
+				/// </summary>
+				template<class F>
+				void execute(F&& f) const
+				{
+					for (auto const& entry : Order_)
+						f(Commands_[entry.index]);
+				}
+
+				// forget the commands and transforms, the memory is kept for the next frame
+				void clear();
+
+				bool empty() const { return Commands_.empty(); }
+				std::size_t size() const { return Commands_.size(); }
+
+			private:
+				struct Entry {
+					SortKey key;
+					std::uint32_t index;
+				};
+
+				std::vector<RenderCommand> Commands_;
+				std::vector<glm::mat4> Transforms_;
+				std::vector<Entry> Order_;
+				std::vector<Entry> Scratch_;
+		};
+	}
+}
+
+#endif
@@ -0,0 +1,52 @@
+#ifndef RENDER_TARGET_H_INCLUDED
+#define RENDER_TARGET_H_INCLUDED
+
+#include <GL/glew.h>
+
+#include "image.h"
+
+namespace ce {
+	namespace Graphic {
+
+		/// <summary>
+		///		Framebuffer object with an RGBA8 color and a 24 bit depth renderbuffer,
+		///		where the offscreen renderer draws instead of a window.
+		/// </summary>
+		class RenderTarget {
+			public:
+				RenderTarget();
+				~RenderTarget();
+
+				// not copyable
+				RenderTarget(RenderTarget const&) = delete;
+				RenderTarget& operator=(RenderTarget const&) = delete;
+
+				// movable
+				RenderTarget(RenderTarget&& other) noexcept;
+				RenderTarget& operator=(RenderTarget&& other) noexcept;
+
+				// (re)create the buffers, false when the framebuffer is not complete
+				bool create(int width, int height);
+				void destroy();
+
+				// draw and read into the target, the viewport covers it
+				void bind();
+
+				// copy the color buffer, rows bottom up like every Image. Waits for the GPU
+				bool read(Image& image);
+
+				GLuint id() const { return Framebuffer_; }
+				int width() const { return Width_; }
+				int height() const { return Height_; }
+
+			private:
+				GLuint Framebuffer_;
+				GLuint Color_;
+				GLuint Depth_;
+				int Width_;
+				int Height_;
+		};
+	}
+}
+
+#endif
@@ -0,0 +1,56 @@
+#ifndef RENDER_THREAD_H_INCLUDED
+#define RENDER_THREAD_H_INCLUDED
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "frame_list.h"
+
+namespace ce {
+	namespace Graphic {
+
+		/// <summary>
+		///		Thread executing the recorded frames, one at a time. While it executes frame N
+		///		the caller records frame N+1 in another list : a frame costs the longest of
+		///		the two instead of their sum.
+		/// </summary>
+		class RenderThread {
+			public:
+				using Execute = std::function<void(FrameList&)>;
+
+				// on_start and on_stop run on the render thread, to take and give back the context
+				RenderThread(std::function<void()> on_start, Execute execute, std::function<void()> on_stop);
+
+				// execute the pending frame, run on_stop and join
+				~RenderThread();
+
+				// not copyable
+				RenderThread(RenderThread const&) = delete;
+				RenderThread& operator=(RenderThread const&) = delete;
+
+				// wait for the previous frame, then hand this one over. The list must live until the next wait.
+				void submit(FrameList* frame);
+
+				// block until the submitted frame is executed
+				void wait();
+
+			private:
+				void run();
+
+				std::function<void()> OnStart_;
+				Execute Execute_;
+				std::function<void()> OnStop_;
+
+				std::mutex Mutex_;
+				std::condition_variable Signal_;
+				FrameList* Pending_;
+				bool Stop_;
+
+				std::thread Thread_;	// last : started once everything else is ready
+		};
+	}
+}
+
+#endif
@@ -0,0 +1,77 @@
+#ifndef RING_BUFFER_H_INCLUDED
+#define RING_BUFFER_H_INCLUDED
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+namespace ce {
+	namespace Core {
+
+		// keep producer and consumer indices on separate cache lines
+		const std::size_t CE_CACHE_LINE = 64;
+
+		/// <summary>
+		///		Fixed size lock-free queue for exactly one producer thread and one consumer thread
+		/// </summary>
+		/// <typeparam name="T">Element type, copied in and out</typeparam>
+		/// <typeparam name="N">Capacity, must be a power of two</typeparam>
+		template<class T, std::size_t N>
+		class SpscRing {
+			static_assert(N >= 2 && (N & (N - 1)) == 0, "SpscRing capacity must be a power of two.");
+
+			public:
+				SpscRing() : Head_{ 0 }, Tail_{ 0 }, Slots_{} {}
+
+				// not copyable
+				SpscRing(SpscRing const&) = delete;
+				SpscRing& operator=(SpscRing const&) = delete;
+
+				/// <summary>
+				///		Producer side. Add an element, fails when the ring is full.
+				/// </summary>
+				bool push(T const& value)
+				{
+					auto const tail = Tail_.load(std::memory_order_relaxed);
+
+					if (tail - Head_.load(std::memory_order_acquire) == N)
+						return false;
+
+					Slots_[tail & (N - 1)] = value;
+					Tail_.store(tail + 1, std::memory_order_release);
+					return true;
+				}
+
+				/// <summary>
+				///		Consumer side. Take the oldest element, fails when the ring is empty.
+				/// </summary>
+				bool pop(T& value)
+				{
+					auto const head = Head_.load(std::memory_order_relaxed);
+
+					if (head == Tail_.load(std::memory_order_acquire))
+						return false;
+
+					value = Slots_[head & (N - 1)];
+					Head_.store(head + 1, std::memory_order_release);
+					return true;
+				}
+
+				std::size_t size() const
+				{
+					return Tail_.load(std::memory_order_acquire) - Head_.load(std::memory_order_acquire);
+				}
+
+				bool empty() const { return size() == 0; }
+
+				static constexpr std::size_t capacity() { return N; }
+
+			private:
+				alignas(CE_CACHE_LINE) std::atomic<std::size_t> Head_; // consumer
+				alignas(CE_CACHE_LINE) std::atomic<std::size_t> Tail_; // producer
+				alignas(CE_CACHE_LINE) std::array<T, N> Slots_;
+		};
+	}
+}
+
+#endif
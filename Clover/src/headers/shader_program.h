@@ -0,0 +1,146 @@
+#ifndef SHADER_PROGRAM_H_INCLUDED
+#define SHADER_PROGRAM_H_INCLUDED
+
+#include <GL/glew.h>
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace ce {
+	namespace Graphic {
+
+		/// <summary>
+		///		Typed index in the uniform table of a program. Found once by name,
+		///		then used on the hot path without any string lookup.
+		///		An invalid handle (uniform optimized out, missing or of another type) makes set() a no-op.
+		/// </summary>
+		template<class T>
+		struct UniformHandle {
+			std::int32_t slot = -1;
+
+			bool valid() const { return slot >= 0; }
+		};
+
+		/// <summary>
+		///		Active uniform, as reported by the driver at link time
+		/// </summary>
+		struct UniformInfo {
+			std::string name;	// without the [0] of arrays
+			GLint location;
+			GLenum type;		// GL_FLOAT_MAT4, GL_FLOAT_VEC3...
+			GLint array_size;
+			std::size_t cache_offset;	// last uploaded value in the shadow buffer
+			std::size_t cache_size;		// bytes of that value, the size of the C++ type set
+			bool cached;		// a value was uploaded since the link
+		};
+
+		/// <summary>
+		///		Active vertex attribute, as reported by the driver at link time
+		/// </summary>
+		struct AttributeInfo {
+			std::string name;
+			GLint location;
+			GLenum type;
+		};
+
+		/// <summary>
+		///		Linked program with its uniforms and attributes reflected once.
+		///		Uniform values are shadowed on the CPU, uploading the value the
+		///		program already holds costs a memcmp and no GL call.
+		/// </summary>
+		class ShaderProgram {
+			public:
+				ShaderProgram(GLuint program_id);
+
+				// not copyable
+				ShaderProgram(ShaderProgram const&) = delete;
+				ShaderProgram& operator=(ShaderProgram const&) = delete;
+
+				GLuint id() const { return Program_; }
+
+				/// <summary>
+				///		Find a uniform by name, at setup time. The type must match the GLSL declaration.
+				/// </summary>
+				template<class T>
+				UniformHandle<T> uniform(std::string const& name) const
+				{
+					auto const slot = find_uniform(name, gl_type<T>());
+					return UniformHandle<T>{ slot };
+				}
+
+				/// <summary>
+				///		Upload a value unless the program already holds it. Binds the program.
+				///		A handle of another program whose slot does not fit T is ignored.
+				/// </summary>
+				template<class T>
+				void set(UniformHandle<T> handle, T const& value)
+				{
+					if (!handle.valid() || static_cast<std::size_t>(handle.slot) >= Uniforms_.size())
+						return;
+
+					auto& u = Uniforms_[handle.slot];
+
+					// the copy below must stay inside the slot, release builds included
+					if (u.cache_size != sizeof(T))
+						return;
+					auto* shadow = Values_.data() + u.cache_offset;
+
+					if (u.cached && std::memcmp(shadow, &value, sizeof(T)) == 0)
+					{
+						++Skipped_;
+						return;
+					}
+
+					std::memcpy(shadow, &value, sizeof(T));
+					u.cached = true;
+					++Uploads_;
+
+					use();
+					upload(u.location, value);
+				}
+
+				// -1 when the attribute is not active
+				GLint attribute(std::string const& name) const;
+
+				std::vector<UniformInfo> const& uniforms() const { return Uniforms_; }
+				std::vector<AttributeInfo> const& attributes() const { return Attributes_; }
+
+				std::size_t uploads() const { return Uploads_; }
+				std::size_t skippedUploads() const { return Skipped_; }
+
+			private:
+				std::int32_t find_uniform(std::string const& name, GLenum type) const;
+				void use() const;
+
+				template<class T> static constexpr GLenum gl_type();
+
+				static void upload(GLint location, float value);
+				static void upload(GLint location, int value);
+				static void upload(GLint location, glm::vec2 const& value);
+				static void upload(GLint location, glm::vec3 const& value);
+				static void upload(GLint location, glm::vec4 const& value);
+				static void upload(GLint location, glm::mat4 const& value);
+
+				GLuint Program_;
+				std::vector<UniformInfo> Uniforms_;
+				std::vector<AttributeInfo> Attributes_;
+				std::vector<unsigned char> Values_;
+				std::size_t Uploads_;
+				std::size_t Skipped_;
+		};
+
+		template<> constexpr GLenum ShaderProgram::gl_type<float>() { return GL_FLOAT; }
+		template<> constexpr GLenum ShaderProgram::gl_type<int>() { return GL_INT; }
+		template<> constexpr GLenum ShaderProgram::gl_type<glm::vec2>() { return GL_FLOAT_VEC2; }
+		template<> constexpr GLenum ShaderProgram::gl_type<glm::vec3>() { return GL_FLOAT_VEC3; }
+		template<> constexpr GLenum ShaderProgram::gl_type<glm::vec4>() { return GL_FLOAT_VEC4; }
+		template<> constexpr GLenum ShaderProgram::gl_type<glm::mat4>() { return GL_FLOAT_MAT4; }
+	}
+}
+
+#endif
@@ -0,0 +1,134 @@
+#ifndef SOFTWARE_RASTERIZER_H_INCLUDED
+#define SOFTWARE_RASTERIZER_H_INCLUDED
+
+#include <glm/glm.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "colors.h"
+#include "image.h"
+#include "job_system.h"
+#include "mesh.h"
+#include "primitive_batch.h"
+#include "utils.h"
+
+namespace ce {
+	namespace Graphic {
+
+		// side of the square screen tiles the triangles are binned into, a tile is rasterized by one thread
+		const int CE_RASTER_TILE_SIZE = 64;
+
+		/// <summary>
+		///		CPU renderer behind the ceRenderer draw API. The triangles are clipped against the near
+		///		plane, set up four at a time with SSE, then binned into screen tiles. flush rasterizes
+		///		the tiles in parallel on the job system, each tile drawing its triangles in submission
+		///		order, so the output does not depend on the thread count. The depth test is GL_LEQUAL,
+		///		the colors are interpolated in screen space and lines are not drawn.
+		/// </summary>
+		class SoftwareRasterizer {
+			public:
+				SoftwareRasterizer(int width, int height);
+
+				// not copyable
+				SoftwareRasterizer(SoftwareRasterizer const&) = delete;
+				SoftwareRasterizer& operator=(SoftwareRasterizer const&) = delete;
+
+				// not movable, the tile jobs keep a pointer on the rasterizer
+				SoftwareRasterizer(SoftwareRasterizer&&) = delete;
+				SoftwareRasterizer& operator=(SoftwareRasterizer&&) = delete;
+
+				// null to rasterize every tile on the calling thread
+				void setJobSystem(Core::JobSystem* jobs) { Jobs_ = jobs; }
+
+				void setClearColor(color<float> clear_color);
+				void clear();
+
+				// meshes get the ids of the MeshRegistry : add them in the same order
+				void addMesh(MeshData const& data);
+
+				// triangle list, mvp is projection * view * model
+				void drawBatch(BatchVertex const* vertices, std::size_t count, glm::mat4 const& mvp);
+				void drawInstances(MeshId mesh, glm::mat4 const& view_projection, InstanceData const* instances, std::size_t count);
+
+				// rasterize the binned triangles, returns once every tile is done. Helper jobs still
+				// queued behind other work are not waited for, they find no tile left and return
+				void flush();
+
+				// color buffer, rows bottom up like every Image
+				bool read(Image& image) const;
+
+				int width() const { return Width_; }
+				int height() const { return Height_; }
+
+				// triangles set up since the creation, after clipping
+				std::size_t triangles() const { return Triangles_; }
+
+			private:
+				struct Vertex {
+					glm::vec4 position;		// clip space
+					color<float> tint;
+				};
+
+				// screen space triangles waiting for their setup, one array per vertex and attribute
+				struct Staged {
+					std::vector<float> x[3], y[3], z[3];
+					std::vector<float> rgba[3][4];
+
+					std::size_t size() const { return x[0].size(); }
+					void clear();
+				};
+
+				// tile cursor shared with the helper jobs, it outlives the rasterizer for the late ones
+				struct TileWork {
+					std::atomic<std::uint64_t> cursor;	// flush generation in the high half, next tile in the low half
+					std::mutex mutex;
+					std::condition_variable finished;
+					std::size_t done;					// tiles rasterized during the current flush
+				};
+
+				// edge and attribute planes : value = a * x + b * y + c, at pixel centers
+				struct Setup {
+					float edges[3][3];		// >= 0 inside
+					bool owns[3];			// the pixels exactly on the edge belong to this triangle
+					float depth[3];
+					float rgba[4][3];
+					int bounds[4];			// pixels : min x, min y, max x, max y
+				};
+
+				void stageTriangles(Vertex const* vertices, std::size_t count);
+				void stage(Vertex const& a, Vertex const& b, Vertex const& c);
+				void setup();
+				void bin(Setup const& triangle);
+				static void rasterizeTiles(SoftwareRasterizer* raster, TileWork& work, std::uint32_t generation, std::size_t tiles);
+				void rasterizeTile(std::size_t tile);
+				void shade(Setup const& triangle, int x, int y, float const row[3], float depth_row, float const rgba_row[4]);
+
+				int Width_;
+				int Height_;
+				int TilesX_;
+				int TilesY_;
+				std::vector<std::uint32_t> Color_;		// RGBA8, red in the low byte
+				std::vector<float> Depth_;
+				std::uint32_t ClearColor_;
+
+				Staged Staged_;
+				std::vector<Setup> Setups_;
+				std::vector<std::vector<std::uint32_t>> Bins_;	// setups touching each tile, in submission order
+				std::vector<std::vector<Core::fVec3>> Meshes_;	// triangle lists, indices expanded
+				std::vector<Vertex> Transformed_;
+				std::size_t Triangles_;
+
+				Core::JobSystem* Jobs_;
+				std::shared_ptr<TileWork> Work_;
+				std::uint32_t Generation_;
+		};
+	}
+}
+
+#endif
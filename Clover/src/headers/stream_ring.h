@@ -0,0 +1,84 @@
+#ifndef STREAM_RING_H_INCLUDED
+#define STREAM_RING_H_INCLUDED
+
+#include <GL/glew.h>
+
+#include <cstddef>
+
+namespace ce {
+	namespace Graphic {
+
+		// segments in flight : the CPU writes one while the GPU reads the two others
+		const std::size_t CE_STREAM_RING_SEGMENTS = 3;
+
+		/// <summary>
+		///		Memory handed out by a StreamRing, write it then commit it before drawing
+		/// </summary>
+		struct StreamAllocation {
+			void* data;			// null when the request does not fit a segment
+			GLintptr offset;	// from the start of the GL buffer
+			GLsizeiptr size;
+		};
+
+		/// <summary>
+		///		Ring allocator for data rewritten every frame, vertices or constants.
+		///		With ARB_buffer_storage the buffer is mapped once, persistently, and cut in segments.
+		///		A fence is put behind each segment when the CPU leaves it and checked when
+		///		the CPU comes back, so a segment is never rewritten while the GPU reads it.
+		///		Without it (3.3 contexts), each allocation maps its range unsynchronized
+		///		and the buffer is orphaned when the ring wraps.
+		/// </summary>
+		class StreamRing {
+			public:
+				StreamRing();
+				~StreamRing();
+
+				// not copyable
+				StreamRing(StreamRing const&) = delete;
+				StreamRing& operator=(StreamRing const&) = delete;
+
+				// movable
+				StreamRing(StreamRing&& other) noexcept;
+				StreamRing& operator=(StreamRing&& other) noexcept;
+
+				// create the buffer, CE_STREAM_RING_SEGMENTS times the segment size
+				void init(GLenum target, GLsizeiptr segment_size);
+				void release();
+
+				// space in the current segment, the offset is a multiple of the alignment
+				StreamAllocation allocate(GLsizeiptr size, GLsizeiptr alignment = 16);
+
+				// false when allocate would leave the current segment, fencing or orphaning it :
+				// issue the draws reading the current segment before that allocation
+				bool fits(GLsizeiptr size, GLsizeiptr alignment = 16) const;
+
+				// make the written data visible to the GPU
+				void commit(StreamAllocation const& allocation);
+
+				// the frame commands are submitted : move on to the next segment
+				void endFrame();
+
+				GLuint id() const { return Buffer_; }
+				bool persistent() const { return Mapped_ != nullptr; }
+				GLsizeiptr segmentSize() const { return SegmentSize_; }
+
+				// times the CPU had to wait for the GPU to release a segment
+				std::size_t stalls() const { return Stalls_; }
+
+			private:
+				void next_segment();
+
+				GLuint Buffer_;
+				GLenum Target_;
+				GLsizeiptr SegmentSize_;
+				unsigned char* Mapped_;		// persistent mapping, null on the fallback path
+				GLsync Fences_[CE_STREAM_RING_SEGMENTS];
+				std::size_t Segment_;
+				GLsizeiptr Head_;			// from the start of the current segment
+				bool RangeMapped_;
+				std::size_t Stalls_;
+		};
+	}
+}
+
+#endif
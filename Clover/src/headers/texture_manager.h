@@ -0,0 +1,119 @@
+#ifndef TEXTURE_MANAGER_H_INCLUDED
+#define TEXTURE_MANAGER_H_INCLUDED
+
+#include <GL/glew.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "image.h"
+#include "job_system.h"
+#include "stream_ring.h"
+
+namespace ce {
+	namespace Graphic {
+
+		using TextureId = std::uint32_t;
+		const TextureId CE_INVALID_TEXTURE = static_cast<TextureId>(-1);
+
+		// bytes of pixels uploaded per frame, a larger texture is uploaded alone in its frame
+		const GLsizeiptr CE_TEXTURE_UPLOAD_BUDGET = 4 << 20;
+
+		// pixel buffer segment : a texture up to twice the budget still goes through a pixel buffer
+		const GLsizeiptr CE_TEXTURE_RING_SEGMENT_SIZE = 2 * CE_TEXTURE_UPLOAD_BUDGET;
+
+		/// <summary>
+		///		A texture as seen by the render side
+		/// </summary>
+		struct Texture {
+			GLuint id;				// 0 until uploaded
+			int width;
+			int height;
+			std::size_t bytes;		// GPU memory, mip levels included
+			bool ready;
+			bool failed;			// the file could not be decoded
+		};
+
+		/// <summary>
+		///		Textures decoded on the job system and uploaded through a ring of pixel buffers,
+		///		so glTexSubImage2D copies from GPU memory without waiting. The uploads of a frame
+		///		are capped by CE_TEXTURE_UPLOAD_BUDGET, the rest waits for the next frames.
+		///		load can be called from any thread, the rest belongs to the thread owning the context.
+		/// </summary>
+		class TextureManager {
+			public:
+				TextureManager();
+
+				// wait for the decodes in flight, then delete the textures
+				~TextureManager();
+
+				// not copyable
+				TextureManager(TextureManager const&) = delete;
+				TextureManager& operator=(TextureManager const&) = delete;
+
+				// not movable, the decode jobs keep a pointer on the manager
+				TextureManager(TextureManager&&) = delete;
+				TextureManager& operator=(TextureManager&&) = delete;
+
+				// create the pixel buffer ring. Without it the textures are only decoded : headless
+				void init();
+
+				// null to decode on the calling thread
+				void setJobSystem(Core::JobSystem* jobs) { Jobs_ = jobs; }
+
+				// decode in the background, the id is valid at once and ready some frames later
+				TextureId load(std::string const& path);
+
+				// upload the decoded textures within the budget, once per frame. The textures becoming ready are appended
+				void update(std::vector<TextureId>& ready);
+
+				// 0 until the texture is uploaded : bind a fallback meanwhile. Only on the thread calling update,
+				// other threads learn the ready textures from update
+				GLuint get(TextureId texture) const;
+				bool ready(TextureId texture) const { return texture < Textures_.size() && Textures_[texture].ready; }
+
+				std::size_t residentBytes() const { return ResidentBytes_; }
+				std::size_t pending() const { return Pending_.size(); }
+
+				// textures too large for a pixel buffer, copied from client memory with a stall
+				std::size_t clientUploads() const { return ClientUploads_; }
+
+				void clear();
+
+			private:
+				struct Decoded {
+					TextureId id;
+					Image image;
+					bool valid;
+				};
+
+				bool upload(Decoded& decoded);
+				void receive();
+
+				Core::JobSystem* Jobs_;
+				std::atomic<TextureId> NextId_;
+
+				// decode side : unbounded, a decode job never waits for the render side
+				std::mutex Mutex_;
+				std::condition_variable Idle_;
+				std::size_t InFlight_;					// decodes not handed over yet
+				std::vector<std::unique_ptr<Decoded>> Decoded_;
+
+				// render side
+				std::deque<std::unique_ptr<Decoded>> Pending_;
+				std::vector<Texture> Textures_;
+				StreamRing Ring_;
+				std::size_t ResidentBytes_;
+				std::size_t ClientUploads_;
+		};
+	}
+}
+
+#endif
@@ -1,14 +1,14 @@
-#ifndef UTILS_H_INCLUDED
-#define UTILS_H_INCLUDED
-
-namespace ce {
-	namespace Core {
-		struct fVec3 {
-			float x;
-			float y;
-			float z;
-		};
-	}
-}
-
-#endif
+#ifndef UTILS_H_INCLUDED
+#define UTILS_H_INCLUDED
+
+namespace ce {
+	namespace Core {
+		struct fVec3 {
+			float x;
+			float y;
+			float z;
+		};
+	}
+}
+
+#endif
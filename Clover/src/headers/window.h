@@ -1,135 +1,321 @@
-﻿#ifndef WINDOW_H_INCLUDED
-#define WINDOW_H_INCLUDED
-
-#include <GL/glew.h> 
-#include <GLFW/glfw3.h>
-
-#include <glm/glm.hpp>
-#include <glm/gtc/matrix_transform.hpp>
-
-#include <iostream>
-#include <memory>
-#include <vector>
-
-#include "colors.h"
-#include "utils.h"
-
-namespace ce {
-    namespace Graphic {
-
-        // temporary string shader. TODO : Fix the load from files method.
-        const std::string CE_VERTEX_SHADER =
-            "#version 330 core \n\
-            \n\
-            layout(location = 0) in vec3 vertexPosition_modelspace;\n\
-            uniform mat4 MVP;\n\
-            void main() {\n\
-                // Output position of the vertex, in clip space : MVP * position\n\
-                gl_Position = MVP * vec4(vertexPosition_modelspace, 1);\n\
-            }";
-
-        // temporary string shader. TODO : Fix the load from files method.
-        const std::string CE_FRAGMENT_SHADER =
-            "#version 330 core\n\
-            \n\
-            out vec3 color;\n\
-            \n\
-            void main() {\n\
-                color = vec3(0,0,1);\n\
-            }";
-
-        struct Triangle {
-            ce::Core::fVec3 point_1;
-            ce::Core::fVec3 point_2;
-            ce::Core::fVec3 point_3;
-        };
-
-        const glm::mat4 CE_IDENTITY_MATRIX = glm::mat4(1.0f);
-
-        /// <summary>
-        ///     Encapsulate an OpenGL (glfw) window.
-        /// </summary>
-        class ceWindow {
-            public:
-
-                /// <summary>
-                ///     Class for draw operations in the window
-                /// </summary>
-                class ceRenderer {
-
-                public:
-                    //move constructor private or protected and make window class friend ?
-                    ceRenderer(ceWindow* w);
-                    ceRenderer();
-
-                    // draw operations
-                    void clear();
-                    void draw();
-                    void drawTriangle(Triangle t);
-
-                    // render options
-                    void setClearColor(color<float> clrcolor) {
-                        glClearColor(clrcolor.r, clrcolor.g, clrcolor.b, clrcolor.a);
-                    };
-
-                    void setClearColor(color<int> clrcolor) {
-                        glClearColor(clrcolor.r / 255.0f, clrcolor.g / 255.0f, clrcolor.b / 255.0f, clrcolor.a / 255.0f);
-                    };
-
-                    // not copyable
-                    ceRenderer(ceRenderer const&) = delete;
-                    ceRenderer& operator=(ceRenderer const&) = delete;
-
-                    // movable
-                    ceRenderer(ceRenderer&& other) noexcept;
-                    ceRenderer& operator=(ceRenderer&& other) noexcept;
-
-                    bool ContextIsRunning();
-                    GLFWwindow* GetContextWindow();
-                    void resize(int width, int height);
-
-                    private:
-                        // handle on the parent window
-                        GLFWwindow* ceWindow_;
-                        ceWindow* WindowHndl_;
-                        GLuint ShaderProgramID_;
-                        GLuint VAO_ID_;
-
-                        glm::mat4 ProjectionMatrix_;
-                        glm::mat4 CameraViewMatrix_;
-
-                }; // END glRender
-
-                ceWindow(std::string, std::size_t, std::size_t);
-
-                bool isOpen();
-
-                ceRenderer* getRendererPtr();
-
-                // not copyable
-                ceWindow(ceWindow const&) = delete;
-                ceWindow& operator=(ceWindow const&) = delete;
-
-                // movable
-                ceWindow(ceWindow&& other) noexcept;
-                ceWindow& operator=(ceWindow&& other) noexcept;
-
-                void resize(int width, int height)
-                {
-                    //do nothing yet
-                }
-
-            private:
-                ceRenderer ceRenderer_;
-
-                std::size_t Width_;
-                std::size_t Height_;
-                std::string Title_;
-
-        }; // END ceWindow
-    }
-}
-
-
-
-#endif
+﻿#ifndef WINDOW_H_INCLUDED
+#define WINDOW_H_INCLUDED
+
+#include <GL/glew.h> 
+#include <GLFW/glfw3.h>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "buffer_manager.h"
+#include "colors.h"
+#include "frame_profiler.h"
+#include "frustum_culling.h"
+#include "mesh.h"
+#include "primitive_batch.h"
+#include "render_queue.h"
+#include "render_target.h"
+#include "render_thread.h"
+#include "shader_program.h"
+#include "software_rasterizer.h"
+#include "stream_ring.h"
+#include "store.h"
+#include "texture_manager.h"
+#include "utils.h"
+
+namespace ce {
+    namespace Graphic {
+
+        // temporary string shader. TODO : Fix the load from files method.
+        const std::string CE_VERTEX_SHADER =
+            "#version 330 core \n\
+            \n\
+            layout(location = 0) in vec3 vertexPosition_modelspace;\n\
+            layout(location = 1) in vec4 vertexColor;\n\
+            uniform mat4 MVP;\n\
+            out vec4 fragmentColor;\n\
+            void main() {\n\
+                // Output position of the vertex, in clip space : MVP * position\n\
+                gl_Position = MVP * vec4(vertexPosition_modelspace, 1);\n\
+                fragmentColor = vertexColor;\n\
+            }";
+
+        // instanced meshes : the model matrix and the color come from the instance buffer
+        const std::string CE_INSTANCED_VERTEX_SHADER =
+            "#version 330 core \n\
+            \n\
+            layout(location = 0) in vec3 vertexPosition_modelspace;\n\
+            layout(location = 1) in mat4 instanceModel;\n\
+            layout(location = 5) in vec4 instanceColor;\n\
+            uniform mat4 VP;\n\
+            out vec4 fragmentColor;\n\
+            void main() {\n\
+                gl_Position = VP * instanceModel * vec4(vertexPosition_modelspace, 1);\n\
+                fragmentColor = instanceColor;\n\
+            }";
+
+        // temporary string shader. TODO : Fix the load from files method.
+        const std::string CE_FRAGMENT_SHADER =
+            "#version 330 core\n\
+            \n\
+            in vec4 fragmentColor;\n\
+            out vec4 color;\n\
+            \n\
+            void main() {\n\
+                color = fragmentColor;\n\
+            }";
+
+        // drawn by the batches while CE_VERTEX_SHADER compiles : position only, flat grey
+        const std::string CE_FALLBACK_VERTEX_SHADER =
+            "#version 330 core \n\
+            \n\
+            layout(location = 0) in vec3 vertexPosition_modelspace;\n\
+            uniform mat4 MVP;\n\
+            out vec4 fragmentColor;\n\
+            void main() {\n\
+                gl_Position = MVP * vec4(vertexPosition_modelspace, 1);\n\
+                fragmentColor = vec4(0.5, 0.5, 0.5, 1.0);\n\
+            }";
+
+        struct Triangle {
+            ce::Core::fVec3 point_1;
+            ce::Core::fVec3 point_2;
+            ce::Core::fVec3 point_3;
+        };
+
+        // points in order around the quad
+        struct Quad {
+            ce::Core::fVec3 point_1;
+            ce::Core::fVec3 point_2;
+            ce::Core::fVec3 point_3;
+            ce::Core::fVec3 point_4;
+        };
+
+        struct Line {
+            ce::Core::fVec3 point_1;
+            ce::Core::fVec3 point_2;
+        };
+
+        const glm::mat4 CE_IDENTITY_MATRIX = glm::mat4(1.0f);
+
+        // streamed bytes per frame before the renderer moves to the next ring segment, a full batch fits
+        const GLsizeiptr CE_STREAM_SEGMENT_SIZE = 8 << 20;
+
+        /// <summary>
+        ///     Where a window renders. Headless windows have no GLFW window and no GL context,
+        ///     their renderer only counts what it is asked to do. Offscreen windows run the full
+        ///     GL path in an EGL context without display and draw into a framebuffer object.
+        ///     Software windows have no GL context either, their triangles are drawn on the CPU.
+        /// </summary>
+        enum class RenderBackend {
+            GLFW,
+            HEADLESS,
+            OFFSCREEN,
+            SOFTWARE
+        };
+
+        /// <summary>
+        ///     Work submitted to a renderer since the last reset
+        /// </summary>
+        struct RenderStats {
+            std::size_t commands;       // every draw operation, clears and state changes included
+            std::size_t draw_calls;
+            std::size_t triangles;
+            std::size_t state_changes;  // program or VAO switches between two draws
+            std::size_t redundant_calls;// GL state changes skipped by the GLFunc cache
+            std::size_t submissions;    // presented frames
+            std::size_t culled;         // entities outside of the view, not drawn
+        };
+
+        /// <summary>
+        ///     Encapsulate an OpenGL (glfw) window.
+        /// </summary>
+        class ceWindow {
+            public:
+
+                /// <summary>
+                ///     Class for draw operations in the window
+                /// </summary>
+                class ceRenderer {
+
+                public:
+                    //move constructor private or protected and make window class friend ?
+                    ceRenderer(ceWindow* w);
+                    ceRenderer();
+                    ~ceRenderer();
+
+                    // draw operations, recorded in a frame list and executed by flush or draw, on this thread
+                    // or on the render thread. The draws are sorted by layer, program, material and VAO :
+                    // use layers to order overlapping draws.
+                    void clear();
+                    void draw();
+                    void drawTriangle(Triangle t);
+                    void drawQuad(Quad q);
+                    void drawLine(Line l);
+                    void flush();
+                    void setLayer(std::uint8_t layer);
+
+                    // move the GL work to a thread owning the context, glfwPollEvents stays on this one
+                    void startRenderThread();
+                    void stopRenderThread();
+                    bool isThreaded() const { return Thread_ != nullptr; }
+
+                    // instanced path : one draw call per mesh for every entity with a Node and a Renderable
+                    MeshId addMesh(std::vector<ce::Core::fVec3> const& positions);
+                    MeshId loadMesh(std::string const& path);   // baked by bake_obj, CE_INVALID_MESH on failure
+                    void drawEntities(ce::Core::Store& store);
+
+                    // textures are decoded on the job system, then uploaded a few per frame when the frames execute
+                    TextureId loadTexture(std::string const& path);
+                    bool textureReady(TextureId texture) const;     // as of the last executed frame
+                    void bindTexture(TextureId texture, GLuint unit = 0);   // nothing is bound until it is ready
+                    void setJobSystem(ce::Core::JobSystem* jobs);
+
+                    // render options
+                    void setClearColor(color<float> clrcolor);
+                    void setDrawColor(color<float> drwcolor) { DrawColor_ = drwcolor; }
+
+                    void setClearColor(color<int> clrcolor) {
+                        setClearColor(color<float>{ clrcolor.r / 255.0f, clrcolor.g / 255.0f, clrcolor.b / 255.0f, clrcolor.a / 255.0f });
+                    };
+
+                    // work counters, the only output of a headless renderer
+                    RenderStats const& stats() const { return Stats_; }
+                    void resetStats() { Stats_ = RenderStats{}; }
+                    bool isHeadless() const { return Headless_; }
+                    bool isOffscreen() const { return Offscreen_; }
+
+                    // last frame drawn offscreen or in software, false for the other backends. Stop the render thread first
+                    bool capture(Image& image);
+
+                    // CPU and GPU time of the passes, a few frames old : the GPU results are never waited for
+                    std::vector<ZoneTiming> frameTimings() const { return Profiler_.frame(); }
+
+                    // not copyable
+                    ceRenderer(ceRenderer const&) = delete;
+                    ceRenderer& operator=(ceRenderer const&) = delete;
+
+                    // movable
+                    ceRenderer(ceRenderer&& other) noexcept;
+                    ceRenderer& operator=(ceRenderer&& other) noexcept;
+
+                    bool ContextIsRunning();
+                    GLFWwindow* GetContextWindow();
+                    void resize(int width, int height);
+                    void close();
+
+                    private:
+                        // handle on the parent window
+                        GLFWwindow* ceWindow_;
+                        ceWindow* WindowHndl_;
+                        GLuint ShaderProgramID_;
+                        ShaderProgram* BatchProgram_;               // reflection of ShaderProgramID_
+                        UniformHandle<glm::mat4> MVP_;
+                        std::size_t BatchRequest_;                  // ShaderProgramID_ compiling, the fallback draws meanwhile
+                        GLuint VAO_ID_;
+
+                        glm::mat4 ProjectionMatrix_;
+                        glm::mat4 CameraViewMatrix_;
+
+                        bool Headless_;
+                        bool Offscreen_;                        // no window : the frames go to Target_
+                        bool CloseRequested_;
+                        RenderStats Stats_;
+                        FrameProfiler Profiler_;                // used by the thread executing the frames
+
+                        // GPU buffers owned by the renderer : static data, then data rewritten every frame
+                        BufferManager Buffers_;
+                        StreamRing Stream_;
+                        RenderTarget Target_;
+
+                        // primitives waiting for the next flush
+                        PrimitiveBatch Batch_;
+                        color<float> DrawColor_;
+
+                        // draws of the frame, sorted before execution
+                        RenderQueue Queue_;
+                        std::uint8_t Layer_;
+
+                        void reserveBatch(BatchPrimitive primitive, std::size_t vertex_count);
+                        void submitBatch();
+
+                        // instanced meshes
+                        MeshRegistry Meshes_;
+                        GLuint InstancedProgramID_;
+                        ShaderProgram* InstancedProgram_;
+                        UniformHandle<glm::mat4> VP_;
+                        std::size_t InstancedRequest_;              // InstancedProgramID_ compiling, no instanced draw meanwhile
+                        std::vector<std::pair<MeshId, InstanceData>> Gathered_;
+                        CullingSet Culling_;                    // bounds of the gathered entities having some
+                        std::vector<std::size_t> Bounded_;      // their index in Gathered_
+                        std::vector<std::uint32_t> Visible_;    // culling output, indices in Culling_
+                        std::vector<std::size_t> MeshFirst_;    // first instance of each mesh, plus the end
+                        std::vector<GLsizei> MeshVertexCounts_; // recording side copy of the registry : vertices or indices per draw
+
+                        // double buffered frame lists : one is recorded while the render thread executes the other
+                        FrameList Frames_[2];
+                        std::size_t Recording_;
+                        std::unique_ptr<RenderThread> Thread_;
+
+                        // behind a pointer : the decode jobs hold the manager, it does not move with the renderer
+                        std::unique_ptr<TextureManager> Textures_;
+                        std::vector<bool> TexturesReady_;       // recording side copy : filled from the executed frames
+
+                        // software backend only, draws the queue on the CPU instead of the GL calls
+                        std::unique_ptr<SoftwareRasterizer> Raster_;
+
+                        FrameList& recording() { return Frames_[Recording_]; }
+                        void makeCurrent();
+                        FrameOp& record(FrameOpType type);
+                        void executeRecorded();
+                        void mergeStats(FrameList const& frame);
+
+                        // execution side, the only place doing GL calls
+                        void executeFrame(FrameList& frame);
+                        void resolvePrograms();
+                        void queueBatch(FrameList& frame, FrameOp const& op);
+                        void queueInstances(FrameList& frame, FrameOp const& op);
+                        void executeQueue(FrameList& frame);
+                        void rasterize(FrameList const& frame, RenderCommand const& c);
+
+                }; // END glRender
+
+                ceWindow(std::string, std::size_t, std::size_t, RenderBackend backend = RenderBackend::GLFW);
+
+                bool isOpen();
+                void close();
+
+                ceRenderer* getRendererPtr();
+
+                // not copyable
+                ceWindow(ceWindow const&) = delete;
+                ceWindow& operator=(ceWindow const&) = delete;
+
+                // movable
+                ceWindow(ceWindow&& other) noexcept;
+                ceWindow& operator=(ceWindow&& other) noexcept;
+
+                void resize(int width, int height)
+                {
+                    //do nothing yet
+                }
+
+            private:
+                ceRenderer ceRenderer_;
+
+                std::size_t Width_;
+                std::size_t Height_;
+                std::string Title_;
+                RenderBackend Backend_;
+
+        }; // END ceWindow
+    }
+}
+
+
+
+#endif
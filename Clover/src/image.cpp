@@ -0,0 +1,219 @@
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+#include "headers/image.h"
+
+namespace ce {
+	namespace Graphic {
+
+		namespace {
+			template<class T>
+			T read_le(unsigned char const* data)
+			{
+				T value = 0;
+				for (std::size_t i = 0; i < sizeof(T); ++i)
+					value |= static_cast<T>(data[i]) << (8 * i);
+				return value;
+			}
+
+			/// <summary>
+			///		Uncompressed BMP, 24 bits BGR or 32 bits BGRA. The rows are stored bottom up.
+			/// </summary>
+			bool decode_bmp(unsigned char const* data, std::size_t size, Image& image)
+			{
+				if (size < 54)
+					return false;
+
+				auto const pixel_offset = read_le<std::uint32_t>(data + 10);
+				auto const width = static_cast<std::int32_t>(read_le<std::uint32_t>(data + 18));
+				auto const stored_height = static_cast<std::int32_t>(read_le<std::uint32_t>(data + 22));
+				auto const bpp = read_le<std::uint16_t>(data + 28);
+				auto const compression = read_le<std::uint32_t>(data + 30);
+
+				// 3 is BI_BITFIELDS, the usual BGRA masks are assumed
+				if ((bpp != 24 && bpp != 32) || (compression != 0 && compression != 3))
+					return false;
+
+				// a negative height means top down rows, widened first so INT_MIN can be negated
+				auto const top_down = stored_height < 0;
+				auto const wide_height = top_down ? -static_cast<std::int64_t>(stored_height) : static_cast<std::int64_t>(stored_height);
+
+				if (width <= 0 || width > CE_IMAGE_MAX_SIZE || wide_height == 0 || wide_height > CE_IMAGE_MAX_SIZE)
+					return false;
+
+				// the dimensions are capped : the sizes below fit a size_t
+				auto const height = static_cast<std::int32_t>(wide_height);
+				auto const channels = bpp / 8u;
+				auto const stride = (static_cast<std::size_t>(width) * channels + 3) / 4 * 4;
+
+				if (pixel_offset > size || stride * static_cast<std::size_t>(height) > size - pixel_offset)
+					return false;
+
+				image.width = width;
+				image.height = height;
+				image.pixels.resize(static_cast<std::size_t>(width) * height * 4);
+
+				for (std::int32_t y = 0; y < height; ++y)
+				{
+					auto const row = data + pixel_offset + stride * (top_down ? height - 1 - y : y);
+					auto out = &image.pixels[static_cast<std::size_t>(y) * width * 4];
+
+					for (std::int32_t x = 0; x < width; ++x, out += 4)
+					{
+						auto const in = row + x * channels;
+						out[0] = in[2];
+						out[1] = in[1];
+						out[2] = in[0];
+						out[3] = channels == 4 ? in[3] : 255;
+					}
+				}
+
+				return true;
+			}
+
+			// PPM header field, skipping the blanks and the comments. -1 on error or above CE_IMAGE_MAX_SIZE
+			long ppm_field(unsigned char const* data, std::size_t size, std::size_t& cursor)
+			{
+				while (cursor < size && (std::isspace(data[cursor]) || data[cursor] == '#'))
+				{
+					if (data[cursor] == '#')
+						while (cursor < size && data[cursor] != '\n')
+							++cursor;
+					else
+						++cursor;
+				}
+
+				long value = -1;
+				while (cursor < size && std::isdigit(data[cursor]))
+				{
+					value = (value < 0 ? 0 : value * 10) + (data[cursor++] - '0');
+
+					// stops before the long can overflow
+					if (value > CE_IMAGE_MAX_SIZE)
+						return -1;
+				}
+
+				return value;
+			}
+
+			/// <summary>
+			///		Binary PPM, 8 bits RGB. The rows are stored top down.
+			/// </summary>
+			bool decode_ppm(unsigned char const* data, std::size_t size, Image& image)
+			{
+				std::size_t cursor = 2;
+				auto const width = ppm_field(data, size, cursor);
+				auto const height = ppm_field(data, size, cursor);
+				auto const max_value = ppm_field(data, size, cursor);
+
+				// a single blank separates the header from the pixels
+				++cursor;
+
+				// the fields are capped by ppm_field : the pixel size fits a size_t
+				if (width <= 0 || height <= 0 || max_value != 255 || cursor > size ||
+					static_cast<std::size_t>(width) * static_cast<std::size_t>(height) * 3 > size - cursor)
+					return false;
+
+				image.width = static_cast<int>(width);
+				image.height = static_cast<int>(height);
+				image.pixels.resize(static_cast<std::size_t>(width) * height * 4);
+
+				for (long y = 0; y < height; ++y)
+				{
+					auto in = data + cursor + static_cast<std::size_t>(height - 1 - y) * width * 3;
+					auto out = &image.pixels[static_cast<std::size_t>(y) * width * 4];
+
+					for (long x = 0; x < width; ++x, in += 3, out += 4)
+					{
+						out[0] = in[0];
+						out[1] = in[1];
+						out[2] = in[2];
+						out[3] = 255;
+					}
+				}
+
+				return true;
+			}
+		}
+
+		/// <summary>
+		///		Decode a picture held in memory, the format is found from its first bytes
+		/// </summary>
+		/// <param name="data">File content</param>
+		/// <param name="size">Bytes of data</param>
+		/// <param name="image">Receives the RGBA pixels</param>
+		/// <returns>False when the format is not supported or the data is truncated</returns>
+		bool decode_image(unsigned char const* data, std::size_t size, Image& image)
+		{
+			if (size >= 2 && data[0] == 'B' && data[1] == 'M')
+				return decode_bmp(data, size, image);
+
+			if (size >= 2 && data[0] == 'P' && data[1] == '6')
+				return decode_ppm(data, size, image);
+
+			return false;
+		}
+
+		/// <summary>
+		///		Read and decode a picture file
+		/// </summary>
+		bool load_image(std::string const& path, Image& image)
+		{
+			std::ifstream stream{ path, std::ios::in | std::ios::binary };
+
+			if (!stream.is_open())
+			{
+				std::cerr << "Can not open image " << path << std::endl;
+				return false;
+			}
+
+			std::vector<unsigned char> content{ std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>() };
+
+			if (!decode_image(content.data(), content.size(), image))
+			{
+				std::cerr << "Unsupported or corrupted image " << path << std::endl;
+				return false;
+			}
+
+			return true;
+		}
+
+		/// <summary>
+		///		Write a picture as a binary PPM, rows top down as the format wants them
+		/// </summary>
+		bool save_image(std::string const& path, Image const& image)
+		{
+			std::ofstream stream{ path, std::ios::out | std::ios::binary };
+
+			if (!stream.is_open())
+			{
+				std::cerr << "Can not write image " << path << std::endl;
+				return false;
+			}
+
+			stream << "P6\n" << image.width << " " << image.height << "\n255\n";
+
+			std::vector<unsigned char> row(static_cast<std::size_t>(image.width) * 3);
+
+			for (int y = image.height - 1; y >= 0; --y)
+			{
+				auto in = &image.pixels[static_cast<std::size_t>(y) * image.width * 4];
+
+				for (std::size_t x = 0; x < row.size(); x += 3, in += 4)
+				{
+					row[x] = in[0];
+					row[x + 1] = in[1];
+					row[x + 2] = in[2];
+				}
+
+				stream.write(reinterpret_cast<char const*>(row.data()), row.size());
+			}
+
+			return stream.good();
+		}
+	}
+}
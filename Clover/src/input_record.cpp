@@ -0,0 +1,295 @@
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+
+#include "headers/input_record.h"
+#include "headers/event_system.h"
+
+namespace ce {
+	namespace Event {
+
+		namespace {
+			template<class T>
+			void put(std::vector<char>& buffer, T value)
+			{
+				char bytes[sizeof(T)];
+				std::memcpy(bytes, &value, sizeof(T));
+				buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+			}
+
+			// false when the data is truncated
+			template<class T>
+			bool get(std::vector<char> const& data, std::size_t& cursor, T& value)
+			{
+				if (cursor + sizeof(T) > data.size())
+					return false;
+
+				std::memcpy(&value, data.data() + cursor, sizeof(T));
+				cursor += sizeof(T);
+				return true;
+			}
+
+			// false when the event is truncated or its type unknown
+			bool get_event(std::vector<char> const& data, std::size_t& cursor, RawEvent& e)
+			{
+				std::uint8_t type = 0;
+
+				if (!get(data, cursor, type) || !get(data, cursor, e.time))
+					return false;
+
+				e.type = static_cast<RawEventType>(type);
+
+				switch (e.type)
+				{
+				case RawEventType::KEY: {
+					std::int16_t key = 0;
+					std::int8_t action = 0, mods = 0;
+
+					if (!get(data, cursor, key) || !get(data, cursor, action) || !get(data, cursor, mods))
+						return false;
+
+					e.key = key;
+					e.action = action;
+					e.mods = mods;
+					return true;
+				}
+
+				case RawEventType::MOUSE_ACTION: {
+					std::int8_t button = 0, action = 0, mods = 0;
+
+					if (!get(data, cursor, button) || !get(data, cursor, action) || !get(data, cursor, mods) ||
+						!get(data, cursor, e.x) || !get(data, cursor, e.y))
+						return false;
+
+					e.key = button;
+					e.action = action;
+					e.mods = mods;
+					return true;
+				}
+
+				case RawEventType::MOUSE_MOVED: {
+					std::int32_t samples = 0;
+
+					if (!get(data, cursor, samples) || !get(data, cursor, e.x) || !get(data, cursor, e.y) ||
+						!get(data, cursor, e.dx) || !get(data, cursor, e.dy))
+						return false;
+
+					e.key = samples;
+					e.action = CE_MOUSE_MOVED;
+					return true;
+				}
+
+				case RawEventType::WINDOW_RESIZED: {
+					std::int32_t width = 0, height = 0;
+
+					if (!get(data, cursor, width) || !get(data, cursor, height))
+						return false;
+
+					e.key = width;
+					e.action = height;
+					return true;
+				}
+				}
+
+				return false;
+			}
+		}
+
+		/// <summary>
+		///		Constructor. Create the file and write the header.
+		/// </summary>
+		/// <param name="path">File to record to, overwritten</param>
+		InputRecorder::InputRecorder(std::string const& path)
+			: File_{ path, std::ios::out | std::ios::binary | std::ios::trunc },
+			Buffer_{},
+			Frame_{ 0 }
+		{
+			if (!File_.is_open())
+			{
+				std::cerr << "Can not open input record file " << path << std::endl;
+				return;
+			}
+
+			File_.write(CE_INPUT_RECORD_MAGIC, sizeof(CE_INPUT_RECORD_MAGIC));
+		}
+
+		/// <summary>
+		///		Append a frame to the file
+		/// </summary>
+		/// <param name="frame_events">Events dispatched during the frame, in reception order</param>
+		void InputRecorder::record(std::vector<RawEvent> const& frame_events)
+		{
+			if (!File_.is_open())
+				return;
+
+			Buffer_.clear();
+			put(Buffer_, static_cast<std::uint32_t>(frame_events.size()));
+
+			for (auto const& e : frame_events)
+			{
+				put(Buffer_, static_cast<std::uint8_t>(e.type));
+				put(Buffer_, e.time);
+
+				switch (e.type)
+				{
+				case RawEventType::KEY:
+					put(Buffer_, static_cast<std::int16_t>(e.key));
+					put(Buffer_, static_cast<std::int8_t>(e.action));
+					put(Buffer_, static_cast<std::int8_t>(e.mods));
+					break;
+
+				case RawEventType::MOUSE_ACTION:
+					put(Buffer_, static_cast<std::int8_t>(e.key));
+					put(Buffer_, static_cast<std::int8_t>(e.action));
+					put(Buffer_, static_cast<std::int8_t>(e.mods));
+					put(Buffer_, e.x);
+					put(Buffer_, e.y);
+					break;
+
+				case RawEventType::MOUSE_MOVED:
+					put(Buffer_, static_cast<std::int32_t>(e.key));
+					put(Buffer_, e.x);
+					put(Buffer_, e.y);
+					put(Buffer_, e.dx);
+					put(Buffer_, e.dy);
+					break;
+
+				case RawEventType::WINDOW_RESIZED:
+					put(Buffer_, static_cast<std::int32_t>(e.key));
+					put(Buffer_, static_cast<std::int32_t>(e.action));
+					break;
+				}
+			}
+
+			File_.write(Buffer_.data(), Buffer_.size());
+			++Frame_;
+		}
+
+		/// <summary>
+		///		Constructor. Load the whole record in memory so the replay never touches the disk.
+		/// </summary>
+		/// <param name="path">File written by an InputRecorder</param>
+		InputReplay::InputReplay(std::string const& path)
+			: Data_{}, Cursor_{ 0 }, Frame_{ 0 }, FrameCount_{ 0 }, Loaded_{ false }
+		{
+			std::ifstream file{ path, std::ios::in | std::ios::binary };
+
+			if (!file.is_open())
+			{
+				std::cerr << "Can not open input record file " << path << std::endl;
+				return;
+			}
+
+			Data_.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+			if (Data_.size() < sizeof(CE_INPUT_RECORD_MAGIC) ||
+				std::memcmp(Data_.data(), CE_INPUT_RECORD_MAGIC, sizeof(CE_INPUT_RECORD_MAGIC)) != 0)
+			{
+				std::cerr << "Invalid input record file " << path << std::endl;
+				Data_.clear();
+				return;
+			}
+
+			// count the frames once, up to the first truncated or corrupted one
+			std::size_t cursor = sizeof(CE_INPUT_RECORD_MAGIC);
+			std::uint32_t count;
+			RawEvent e{};
+
+			while (get(Data_, cursor, count))
+			{
+				std::uint32_t i = 0;
+				while (i < count && get_event(Data_, cursor, e))
+					++i;
+
+				if (i < count)
+					break;
+
+				++FrameCount_;
+			}
+
+			Cursor_ = sizeof(CE_INPUT_RECORD_MAGIC);
+			Loaded_ = true;
+		}
+
+		/// <summary>
+		///		Queue the events of the next recorded frame
+		/// </summary>
+		/// <param name="es">Event system receiving the events</param>
+		void InputReplay::poll(glEventSystem& es)
+		{
+			if (!Loaded_ || done())
+				return;
+
+			std::uint32_t count = 0;
+			bool valid = get(Data_, Cursor_, count);
+
+			for (std::uint32_t i = 0; valid && i < count; ++i)
+			{
+				RawEvent e{};
+				valid = get_event(Data_, Cursor_, e);
+
+				if (valid)
+					es.inject(e);
+			}
+
+			// the frames were counted on valid data, but never inject what could not be read
+			if (!valid)
+			{
+				std::cerr << "Corrupted input record at frame " << Frame_ << ", the replay ends." << std::endl;
+				FrameCount_ = Frame_;
+				return;
+			}
+
+			++Frame_;
+		}
+
+		/// <summary>
+		///		Constructor
+		/// </summary>
+		/// <param name="seed">Same seed, same stream</param>
+		/// <param name="width">Width of the area the cursor moves in</param>
+		/// <param name="height">Height of the area the cursor moves in</param>
+		SyntheticEventSource::SyntheticEventSource(std::uint32_t seed, double width, double height)
+			: Random_{ seed }, Width_{ width }, Height_{ height }, Time_{ 0.0 },
+			MouseX_{ width / 2.0 }, MouseY_{ height / 2.0 }
+		{}
+
+		/// <summary>
+		///		Queue the events of a simulated 60 Hz frame
+		/// </summary>
+		/// <param name="es">Event system receiving the events</param>
+		void SyntheticEventSource::poll(glEventSystem& es)
+		{
+			Time_ += 1.0 / 60.0;
+
+			std::uniform_int_distribution<int> percent{ 0, 99 };
+			std::uniform_int_distribution<int> letter{ CE_KEY_A, CE_KEY_Z };
+			std::uniform_real_distribution<double> motion{ -8.0, 8.0 };
+
+			// a key changes state on a few frames only
+			if (percent(Random_) < 10)
+			{
+				auto const action = percent(Random_) < 50 ? CE_KEY_PRESSED : CE_KEY_RELEASED;
+				es.inject(RawEvent{ Time_, RawEventType::KEY, letter(Random_), action, 0, 0.0, 0.0, 0.0, 0.0 });
+			}
+
+			// the mouse moves most of the time
+			if (percent(Random_) < 80)
+			{
+				auto const dx = motion(Random_);
+				auto const dy = motion(Random_);
+				MouseX_ = std::min(std::max(MouseX_ + dx, 0.0), Width_);
+				MouseY_ = std::min(std::max(MouseY_ + dy, 0.0), Height_);
+
+				es.inject(RawEvent{ Time_, RawEventType::MOUSE_MOVED, 1, CE_MOUSE_MOVED, 0, MouseX_, MouseY_, dx, dy });
+			}
+
+			if (percent(Random_) < 2)
+			{
+				auto const action = percent(Random_) < 50 ? CE_MOUSE_PRESSED : CE_MOUSE_RELEASED;
+				es.inject(RawEvent{ Time_, RawEventType::MOUSE_ACTION, CE_MOUSE_L, action, 0, MouseX_, MouseY_, 0.0, 0.0 });
+			}
+		}
+	}
+}
@@ -0,0 +1,83 @@
+#include "headers/input_state.h"
+#include "headers/event_system.h"
+
+namespace ce {
+	namespace Event {
+
+		/// <summary>
+		///		Constructor. Nothing held, cursor at the origin.
+		/// </summary>
+		InputState::InputState()
+			: Down_{}, Pressed_{}, Released_{},
+			MouseDown_{}, MousePressed_{}, MouseReleased_{},
+			MouseX_{ 0.0 }, MouseY_{ 0.0 }, MouseDX_{ 0.0 }, MouseDY_{ 0.0 },
+			Frame_{ 0 }
+		{}
+
+		/// <summary>
+		///		Start the next frame
+		/// </summary>
+		void InputState::beginFrame()
+		{
+			Pressed_.reset();
+			Released_.reset();
+			MousePressed_.reset();
+			MouseReleased_.reset();
+			MouseDX_ = 0.0;
+			MouseDY_ = 0.0;
+			++Frame_;
+		}
+
+		/// <summary>
+		///		Update the state with an event of the frame
+		/// </summary>
+		/// <param name="event">Event, in reception order</param>
+		void InputState::apply(RawEvent const& event)
+		{
+			switch (event.type)
+			{
+			case RawEventType::KEY:
+				if (!valid_key(event.key))
+					break;
+
+				if (event.action == CE_KEY_PRESSED)
+				{
+					Down_.set(event.key);
+					Pressed_.set(event.key);
+				}
+				else if (event.action == CE_KEY_RELEASED)
+				{
+					Down_.reset(event.key);
+					Released_.set(event.key);
+				}
+				break;
+
+			case RawEventType::MOUSE_ACTION:
+				if (!valid_button(event.key))
+					break;
+
+				if (event.action == CE_MOUSE_PRESSED)
+				{
+					MouseDown_.set(event.key);
+					MousePressed_.set(event.key);
+				}
+				else if (event.action == CE_MOUSE_RELEASED)
+				{
+					MouseDown_.reset(event.key);
+					MouseReleased_.set(event.key);
+				}
+				break;
+
+			case RawEventType::MOUSE_MOVED:
+				MouseX_ = event.x;
+				MouseY_ = event.y;
+				MouseDX_ += event.dx;
+				MouseDY_ += event.dy;
+				break;
+
+			default:
+				break;
+			}
+		}
+	}
+}
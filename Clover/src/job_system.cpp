@@ -0,0 +1,95 @@
+#include "headers/job_system.h"
+
+namespace ce {
+	namespace Core {
+
+		/// <summary>
+		///		Constructor. Start the worker threads.
+		/// </summary>
+		/// <param name="workers">Number of worker threads, 0 to pick from the hardware</param>
+		JobSystem::JobSystem(std::size_t workers)
+			: Running_{ 0 }, Stop_{ false }
+		{
+			if (workers == 0)
+			{
+				auto const hw = std::thread::hardware_concurrency();
+				workers = hw > 1 ? hw - 1 : 1;
+			}
+
+			for (std::size_t i = 0; i < workers; ++i)
+				Workers_.emplace_back(&JobSystem::work, this);
+		}
+
+		/// <summary>
+		///		Destructor. Finish the queued jobs and join the workers.
+		/// </summary>
+		JobSystem::~JobSystem()
+		{
+			{
+				std::lock_guard<std::mutex> lock{ Mutex_ };
+				Stop_ = true;
+			}
+
+			JobReady_.notify_all();
+
+			for (auto& worker : Workers_)
+				worker.join();
+		}
+
+		/// <summary>
+		///		Queue a job to be run by the first available worker
+		/// </summary>
+		/// <param name="job">The job to run</param>
+		void JobSystem::submit(Job job)
+		{
+			{
+				std::lock_guard<std::mutex> lock{ Mutex_ };
+				Jobs_.push_back(std::move(job));
+			}
+
+			JobReady_.notify_one();
+		}
+
+		/// <summary>
+		///		Block until every submitted job has been run
+		/// </summary>
+		void JobSystem::wait()
+		{
+			std::unique_lock<std::mutex> lock{ Mutex_ };
+			Idle_.wait(lock, [this] { return Jobs_.empty() && Running_ == 0; });
+		}
+
+		/// <summary>
+		///		Worker loop
+		/// </summary>
+		void JobSystem::work()
+		{
+			for (;;)
+			{
+				Job job;
+
+				{
+					std::unique_lock<std::mutex> lock{ Mutex_ };
+					JobReady_.wait(lock, [this] { return Stop_ || !Jobs_.empty(); });
+
+					if (Jobs_.empty())
+						return; // stopping and nothing left to do
+
+					job = std::move(Jobs_.front());
+					Jobs_.pop_front();
+					++Running_;
+				}
+
+				job();
+
+				{
+					std::lock_guard<std::mutex> lock{ Mutex_ };
+					--Running_;
+
+					if (Jobs_.empty() && Running_ == 0)
+						Idle_.notify_all();
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,169 @@
+#include <iostream>
+
+#include "headers/mapped_file.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace ce {
+	namespace Core {
+
+		/// <summary>
+		///		Constructor, no file
+		/// </summary>
+		MappedFile::MappedFile()
+			: Data_{ nullptr }, Size_{ 0 }
+#ifdef _WIN32
+			, File_{ nullptr }, Mapping_{ nullptr }
+#endif
+		{}
+
+		/// <summary>
+		///		Constructor. Map the file, isOpen tells if it worked.
+		/// </summary>
+		/// <param name="path">File to map</param>
+		MappedFile::MappedFile(std::string const& path)
+			: MappedFile{}
+		{
+#ifdef _WIN32
+			auto file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+
+			if (file == INVALID_HANDLE_VALUE)
+			{
+				std::cerr << "Can not open file " << path << std::endl;
+				return;
+			}
+
+			LARGE_INTEGER size;
+			if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+			{
+				std::cerr << "Can not map empty file " << path << std::endl;
+				CloseHandle(file);
+				return;
+			}
+
+			auto mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			auto view = mapping != nullptr ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+
+			if (view == nullptr)
+			{
+				std::cerr << "Can not map file " << path << std::endl;
+				if (mapping != nullptr)
+					CloseHandle(mapping);
+				CloseHandle(file);
+				return;
+			}
+
+			File_ = file;
+			Mapping_ = mapping;
+			Data_ = static_cast<unsigned char const*>(view);
+			Size_ = static_cast<std::size_t>(size.QuadPart);
+#else
+			auto fd = open(path.c_str(), O_RDONLY);
+
+			if (fd < 0)
+			{
+				std::cerr << "Can not open file " << path << std::endl;
+				return;
+			}
+
+			struct stat st;
+			if (fstat(fd, &st) != 0 || st.st_size == 0)
+			{
+				std::cerr << "Can not map empty file " << path << std::endl;
+				::close(fd);
+				return;
+			}
+
+			auto view = mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+
+			// the mapping keeps the file alive
+			::close(fd);
+
+			if (view == MAP_FAILED)
+			{
+				std::cerr << "Can not map file " << path << std::endl;
+				return;
+			}
+
+			Data_ = static_cast<unsigned char const*>(view);
+			Size_ = static_cast<std::size_t>(st.st_size);
+#endif
+		}
+
+		/// <summary>
+		///		Destructor. Unmap the file.
+		/// </summary>
+		MappedFile::~MappedFile()
+		{
+			close();
+		}
+
+		/// <summary>
+		///		Move constructor
+		/// </summary>
+		/// <param name="other">File to move, left closed</param>
+		MappedFile::MappedFile(MappedFile&& other) noexcept
+			: MappedFile{}
+		{
+			*this = std::move(other);
+		}
+
+		/// <summary>
+		///		Move assignement
+		/// </summary>
+		/// <param name="other">File to move, left closed</param>
+		MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+		{
+			if (this != &other)
+			{
+				close();
+
+				Data_ = other.Data_;
+				Size_ = other.Size_;
+				other.Data_ = nullptr;
+				other.Size_ = 0;
+#ifdef _WIN32
+				File_ = other.File_;
+				Mapping_ = other.Mapping_;
+				other.File_ = nullptr;
+				other.Mapping_ = nullptr;
+#endif
+			}
+
+			return *this;
+		}
+
+		/// <summary>
+		///		Unmap the file, the views on its data become invalid
+		/// </summary>
+		void MappedFile::close()
+		{
+#ifdef _WIN32
+			if (Data_ != nullptr)
+				UnmapViewOfFile(Data_);
+			if (Mapping_ != nullptr)
+				CloseHandle(Mapping_);
+			if (File_ != nullptr)
+				CloseHandle(File_);
+
+			File_ = nullptr;
+			Mapping_ = nullptr;
+#else
+			if (Data_ != nullptr)
+				munmap(const_cast<unsigned char*>(Data_), Size_);
+#endif
+
+			Data_ = nullptr;
+			Size_ = 0;
+		}
+	}
+}
@@ -0,0 +1,146 @@
+#include <assert.h>
+#include <cstddef>
+
+#include "headers/mesh.h"
+#include "headers/glFunc.h"
+
+namespace ce {
+	namespace Graphic {
+
+		/// <summary>
+		///		Constructor
+		/// </summary>
+		MeshRegistry::MeshRegistry()
+			: Meshes_{}
+		{}
+
+		/// <summary>
+		///		Destructor. Delete the VAOs, the vertex buffers belong to their BufferManager.
+		/// </summary>
+		MeshRegistry::~MeshRegistry()
+		{
+			clear();
+		}
+
+		/// <summary>
+		///		Move constructor
+		/// </summary>
+		/// <param name="other">Registry to move, left empty</param>
+		MeshRegistry::MeshRegistry(MeshRegistry&& other) noexcept
+			: Meshes_{ std::move(other.Meshes_) }
+		{
+			other.Meshes_.clear();
+		}
+
+		/// <summary>
+		///		Move assignement
+		/// </summary>
+		/// <param name="other">Registry to move, left empty</param>
+		MeshRegistry& MeshRegistry::operator=(MeshRegistry&& other) noexcept
+		{
+			if (this != &other)
+			{
+				clear();
+				Meshes_ = std::move(other.Meshes_);
+				other.Meshes_.clear();
+			}
+
+			return *this;
+		}
+
+		/// <summary>
+		///		Upload a mesh and record its vertex layout
+		/// </summary>
+		/// <param name="positions">Triangle list, 3 points per triangle</param>
+		/// <param name="buffers">Manager owning the vertex buffer, null when headless</param>
+		/// <returns>Id of the mesh, used by the Renderable components</returns>
+		MeshId MeshRegistry::add(std::vector<Core::fVec3> const& positions, BufferManager* buffers)
+		{
+			return add(MeshData{ positions.data(), positions.size(), nullptr, 0, 0 }, buffers);
+		}
+
+		/// <summary>
+		///		Upload a mesh, indexed or not, and record its vertex layout
+		/// </summary>
+		/// <param name="data">Vertices and indices, read during the call only</param>
+		/// <param name="buffers">Manager owning the vertex and index buffers, null when headless</param>
+		/// <returns>Id of the mesh, used by the Renderable components</returns>
+		MeshId MeshRegistry::add(MeshData const& data, BufferManager* buffers)
+		{
+			assert((data.indices == nullptr || data.index_type == GL_UNSIGNED_SHORT || data.index_type == GL_UNSIGNED_INT) && "Invalid index type.");
+
+			auto const indexed = data.indices != nullptr;
+			Mesh mesh{ 0, CE_INVALID_BUFFER, static_cast<GLsizei>(data.vertex_count),
+				CE_INVALID_BUFFER, indexed ? static_cast<GLsizei>(data.index_count) : 0, indexed ? data.index_type : 0 };
+
+			if (buffers != nullptr)
+			{
+				mesh.vertices = buffers->create(GL_ARRAY_BUFFER, BufferUsage::STATIC, data.vertex_count * sizeof(Core::fVec3), data.positions);
+				mesh.vao = GLFunc::GetVAO();
+
+				GLFunc::BindVAO(mesh.vao);
+				GLFunc::BindBuffer(GL_ARRAY_BUFFER, buffers->id(mesh.vertices));
+				GLFunc::VertexAttribPointer(0, 3, GL_FLOAT, 0, 0);
+				GLFunc::EnableAttribute(0);
+
+				// created with the VAO bound : the element array binding is recorded in the VAO
+				if (indexed)
+				{
+					auto const index_size = data.index_type == GL_UNSIGNED_SHORT ? sizeof(GLushort) : sizeof(GLuint);
+					mesh.indices = buffers->create(GL_ELEMENT_ARRAY_BUFFER, BufferUsage::STATIC, data.index_count * index_size, data.indices);
+				}
+
+				// the instance attributes advance once per instance, their pointers are set at draw time
+				for (GLuint i = 0; i < 4; ++i)
+				{
+					GLFunc::EnableAttribute(CE_INSTANCE_MODEL_LOCATION + i);
+					GLFunc::VertexAttribDivisor(CE_INSTANCE_MODEL_LOCATION + i, 1);
+				}
+
+				GLFunc::EnableAttribute(CE_INSTANCE_COLOR_LOCATION);
+				GLFunc::VertexAttribDivisor(CE_INSTANCE_COLOR_LOCATION, 1);
+
+				GLFunc::UnbindVao();
+			}
+
+			Meshes_.push_back(mesh);
+			return Meshes_.size() - 1;
+		}
+
+		/// <summary>
+		///		Bind a mesh for an instanced draw. The instances of every mesh share one streaming buffer,
+		///		so the attribute pointers are moved to the range of this draw.
+		/// </summary>
+		/// <param name="mesh">Mesh to draw</param>
+		/// <param name="instance_buffer">GL buffer of InstanceData</param>
+		/// <param name="offset">Bytes from the start of the buffer to the first instance</param>
+		void MeshRegistry::bindInstances(MeshId mesh, GLuint instance_buffer, GLintptr offset) const
+		{
+			assert(valid(mesh) && Meshes_[mesh].vao != 0 && "Invalid mesh id.");
+
+			auto const stride = static_cast<GLsizei>(sizeof(InstanceData));
+
+			GLFunc::BindVAO(Meshes_[mesh].vao);
+			GLFunc::BindBuffer(GL_ARRAY_BUFFER, instance_buffer);
+
+			for (GLuint i = 0; i < 4; ++i)
+				GLFunc::VertexAttribPointer(CE_INSTANCE_MODEL_LOCATION + i, 4, GL_FLOAT, stride, offset + offsetof(InstanceData, model) + i * sizeof(glm::vec4));
+
+			GLFunc::VertexAttribPointer(CE_INSTANCE_COLOR_LOCATION, 4, GL_FLOAT, stride, offset + offsetof(InstanceData, tint));
+		}
+
+		/// <summary>
+		///		Forget every mesh
+		/// </summary>
+		void MeshRegistry::clear()
+		{
+			// the context may already be gone at shutdown, the VAOs went with it
+			if (GLFunc::IsReady())
+				for (auto const& m : Meshes_)
+					if (m.vao != 0)
+						GLFunc::DeleteVAO(m.vao);
+
+			Meshes_.clear();
+		}
+	}
+}
@@ -0,0 +1,224 @@
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#include "headers/mesh_file.h"
+
+namespace ce {
+	namespace Graphic {
+
+		namespace {
+			// index of the first index out of the vertex range, count if there is none
+			template<class T>
+			std::size_t find_invalid_index(unsigned char const* data, std::size_t count, std::uint32_t vertex_count)
+			{
+				for (std::size_t i = 0; i < count; ++i)
+				{
+					T index;
+					std::memcpy(&index, data + i * sizeof(T), sizeof(T));
+
+					if (index >= vertex_count)
+						return i;
+				}
+
+				return count;
+			}
+		}
+
+		/// <summary>
+		///		Constructor. Map the file and check its header, its size and its indices.
+		/// </summary>
+		/// <param name="path">Mesh baked by bake_obj</param>
+		MeshFile::MeshFile(std::string const& path)
+			: File_{ path }, Valid_{ false }
+		{
+			if (!File_.isOpen())
+				return;
+
+			MeshFileHeader header;
+
+			if (File_.size() < sizeof(header))
+			{
+				std::cerr << "Truncated mesh file " << path << std::endl;
+				return;
+			}
+
+			std::memcpy(&header, File_.data(), sizeof(header));
+
+			if (std::memcmp(header.magic, CE_MESH_FILE_MAGIC, sizeof(CE_MESH_FILE_MAGIC)) != 0 ||
+				(header.index_size != 2 && header.index_size != 4))
+			{
+				std::cerr << "Not a mesh file or wrong version : " << path << std::endl;
+				return;
+			}
+
+			auto const expected = sizeof(header) + std::size_t{ header.vertex_count } * sizeof(Core::fVec3) +
+				std::size_t{ header.index_count } * header.index_size;
+
+			if (File_.size() < expected)
+			{
+				std::cerr << "Truncated mesh file " << path << std::endl;
+				return;
+			}
+
+			// the mesh is drawn as a triangle list, by index or by vertex without indices
+			if ((header.index_count > 0 ? header.index_count : header.vertex_count) % 3 != 0)
+			{
+				std::cerr << "Mesh file " << path << " is not made of triangles" << std::endl;
+				return;
+			}
+
+			// scanned once here so a stale or corrupt file never makes a draw read past the vertices
+			auto const indices = File_.data() + sizeof(header) + std::size_t{ header.vertex_count } * sizeof(Core::fVec3);
+			auto const invalid = header.index_size == 2
+				? find_invalid_index<std::uint16_t>(indices, header.index_count, header.vertex_count)
+				: find_invalid_index<std::uint32_t>(indices, header.index_count, header.vertex_count);
+
+			if (invalid != header.index_count)
+			{
+				std::cerr << "Mesh file " << path << " : index " << invalid << " is out of the vertex range" << std::endl;
+				return;
+			}
+
+			Valid_ = true;
+		}
+
+		/// <summary>
+		///		Point into the mapping, nothing is copied
+		/// </summary>
+		MeshData MeshFile::data() const
+		{
+			if (!Valid_)
+				return MeshData{ nullptr, 0, nullptr, 0, 0 };
+
+			MeshFileHeader header;
+			std::memcpy(&header, File_.data(), sizeof(header));
+
+			// the header size and the positions keep the arrays 4 bytes aligned
+			auto const positions = File_.data() + sizeof(header);
+			auto const indices = positions + std::size_t{ header.vertex_count } * sizeof(Core::fVec3);
+
+			return MeshData{
+				reinterpret_cast<Core::fVec3 const*>(positions),
+				header.vertex_count,
+				header.index_count > 0 ? indices : nullptr,
+				header.index_count,
+				static_cast<GLenum>(header.index_size == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT)
+			};
+		}
+
+		namespace {
+			// OBJ face corner "v", "v/vt", "v//vn" or "v/vt/vn" : the position index, 0 based. -1 if invalid
+			long corner_index(std::string const& corner, std::size_t vertex_count)
+			{
+				auto const index = std::strtol(corner.c_str(), nullptr, 10);
+
+				// negative indices count from the last vertex read
+				auto const resolved = index < 0 ? static_cast<long>(vertex_count) + index : index - 1;
+
+				return resolved >= 0 && resolved < static_cast<long>(vertex_count) ? resolved : -1;
+			}
+
+			template<class T>
+			void write_indices(std::ofstream& out, std::vector<std::uint32_t> const& indices)
+			{
+				std::vector<T> narrowed(indices.begin(), indices.end());
+				out.write(reinterpret_cast<char const*>(narrowed.data()), narrowed.size() * sizeof(T));
+			}
+		}
+
+		/// <summary>
+		///		Convert an OBJ file to the baked format. Only the positions are kept,
+		///		the faces become triangles sharing the vertices through indices.
+		/// </summary>
+		/// <param name="obj_path">Text OBJ file</param>
+		/// <param name="mesh_path">Baked file, overwritten</param>
+		/// <returns>False when a file can not be opened or a face is invalid</returns>
+		bool bake_obj(std::string const& obj_path, std::string const& mesh_path)
+		{
+			std::ifstream in{ obj_path };
+
+			if (!in.is_open())
+			{
+				std::cerr << "Can not open OBJ file " << obj_path << std::endl;
+				return false;
+			}
+
+			std::vector<Core::fVec3> positions;
+			std::vector<std::uint32_t> indices;
+			std::vector<long> face;
+
+			std::string line, keyword, corner;
+			std::size_t line_number = 0;
+
+			while (std::getline(in, line))
+			{
+				++line_number;
+
+				std::istringstream tokens{ line };
+				if (!(tokens >> keyword))
+					continue;
+
+				if (keyword == "v")
+				{
+					Core::fVec3 p{ 0.0f, 0.0f, 0.0f };
+					tokens >> p.x >> p.y >> p.z;
+					positions.push_back(p);
+				}
+				else if (keyword == "f")
+				{
+					face.clear();
+					while (tokens >> corner)
+						face.push_back(corner_index(corner, positions.size()));
+
+					for (auto const index : face)
+						if (index < 0)
+						{
+							std::cerr << obj_path << ":" << line_number << " : invalid face" << std::endl;
+							return false;
+						}
+
+					// fan triangulation, OBJ polygons are convex
+					for (std::size_t i = 2; i < face.size(); ++i)
+					{
+						indices.push_back(static_cast<std::uint32_t>(face[0]));
+						indices.push_back(static_cast<std::uint32_t>(face[i - 1]));
+						indices.push_back(static_cast<std::uint32_t>(face[i]));
+					}
+				}
+			}
+
+			std::ofstream out{ mesh_path, std::ios::out | std::ios::binary | std::ios::trunc };
+
+			if (!out.is_open())
+			{
+				std::cerr << "Can not open mesh file " << mesh_path << std::endl;
+				return false;
+			}
+
+			// 16 bit indices when every vertex can be addressed with them
+			MeshFileHeader header{};
+			std::memcpy(header.magic, CE_MESH_FILE_MAGIC, sizeof(CE_MESH_FILE_MAGIC));
+			header.vertex_count = static_cast<std::uint32_t>(positions.size());
+			header.index_count = static_cast<std::uint32_t>(indices.size());
+			header.index_size = positions.size() <= 0x10000 ? 2 : 4;
+
+			out.write(reinterpret_cast<char const*>(&header), sizeof(header));
+			out.write(reinterpret_cast<char const*>(positions.data()), positions.size() * sizeof(Core::fVec3));
+
+			if (header.index_size == 2)
+				write_indices<std::uint16_t>(out, indices);
+			else
+				write_indices<std::uint32_t>(out, indices);
+
+#ifdef CE_VERBOSE
+			std::cout << "Baked " << obj_path << " : " << positions.size() << " vertices, " << indices.size() / 3 << " triangles" << std::endl;
+#endif
+
+			return out.good();
+		}
+	}
+}
@@ -0,0 +1,219 @@
+#include <cstring>
+#include <iostream>
+
+// EGL is only included here : eglew.h refuses to follow egl.h
+#ifdef CE_USE_EGL
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#endif
+
+#include "headers/offscreen_context.h"
+
+namespace ce {
+	namespace Graphic {
+
+		/// <summary>
+		///		Constructor. The context is made by create.
+		/// </summary>
+		OffscreenContext::OffscreenContext()
+			: Display_{ nullptr },
+			Context_{ nullptr },
+			Surface_{ nullptr }
+		{}
+
+		/// <summary>
+		///		Destructor
+		/// </summary>
+		OffscreenContext::~OffscreenContext()
+		{
+			destroy();
+		}
+
+#ifdef CE_USE_EGL
+
+		namespace {
+			bool has_extension(char const* extensions, char const* name)
+			{
+				if (extensions == nullptr)
+					return false;
+
+				auto const length = std::strlen(name);
+
+				for (auto p = std::strstr(extensions, name); p != nullptr; p = std::strstr(p + length, name))
+					if ((p == extensions || p[-1] == ' ') && (p[length] == ' ' || p[length] == '\0'))
+						return true;
+
+				return false;
+			}
+
+			/// <summary>
+			///		Mesa's surfaceless platform needs neither X server nor GPU, then the default display
+			/// </summary>
+			EGLDisplay open_display()
+			{
+				auto const client_extensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+
+				if (has_extension(client_extensions, "EGL_MESA_platform_surfaceless"))
+				{
+					auto get_platform_display = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+
+					if (get_platform_display != nullptr)
+					{
+						auto display = get_platform_display(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+						if (display != EGL_NO_DISPLAY && eglInitialize(display, nullptr, nullptr))
+							return display;
+					}
+				}
+
+				auto display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+				if (display != EGL_NO_DISPLAY && eglInitialize(display, nullptr, nullptr))
+					return display;
+
+				return EGL_NO_DISPLAY;
+			}
+		}
+
+		/// <summary>
+		///		Open the display and create the context
+		/// </summary>
+		/// <param name="major">GL major version</param>
+		/// <param name="minor">GL minor version</param>
+		/// <returns>False when no display or no matching context is available</returns>
+		bool OffscreenContext::create(int major, int minor)
+		{
+			destroy();
+
+			auto display = open_display();
+
+			if (display == EGL_NO_DISPLAY)
+			{
+				std::cerr << "EGL : no display could be initialized." << std::endl;
+				return false;
+			}
+
+			Display_ = display;
+
+			if (!eglBindAPI(EGL_OPENGL_API))
+			{
+				std::cerr << "EGL : desktop OpenGL is not supported." << std::endl;
+				destroy();
+				return false;
+			}
+
+			EGLint const config_attributes[] = {
+				EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+				EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+				EGL_RED_SIZE, 8,
+				EGL_GREEN_SIZE, 8,
+				EGL_BLUE_SIZE, 8,
+				EGL_ALPHA_SIZE, 8,
+				EGL_DEPTH_SIZE, 24,
+				EGL_NONE
+			};
+
+			EGLConfig config = nullptr;
+			EGLint config_count = 0;
+
+			if (!eglChooseConfig(display, config_attributes, &config, 1, &config_count) || config_count == 0)
+			{
+				std::cerr << "EGL : no RGBA8 config with a depth buffer." << std::endl;
+				destroy();
+				return false;
+			}
+
+			EGLint const context_attributes[] = {
+				EGL_CONTEXT_MAJOR_VERSION, major,
+				EGL_CONTEXT_MINOR_VERSION, minor,
+				EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+				EGL_NONE
+			};
+
+			Context_ = eglCreateContext(display, config, EGL_NO_CONTEXT, context_attributes);
+
+			if (Context_ == EGL_NO_CONTEXT)
+			{
+				std::cerr << "EGL : failed to create an OpenGL " << major << "." << minor << " core context." << std::endl;
+				Context_ = nullptr;
+				destroy();
+				return false;
+			}
+
+			// every frame goes to a framebuffer object, a surface is only needed when EGL insists on one
+			if (!has_extension(eglQueryString(display, EGL_EXTENSIONS), "EGL_KHR_surfaceless_context"))
+			{
+				EGLint const pbuffer_attributes[] = { EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE };
+				Surface_ = eglCreatePbufferSurface(display, config, pbuffer_attributes);
+
+				if (Surface_ == EGL_NO_SURFACE)
+				{
+					std::cerr << "EGL : failed to create the pbuffer surface." << std::endl;
+					Surface_ = nullptr;
+					destroy();
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		/// <summary>
+		///		Make the context current on the calling thread
+		/// </summary>
+		bool OffscreenContext::makeCurrent()
+		{
+			auto const surface = Surface_ != nullptr ? static_cast<EGLSurface>(Surface_) : EGL_NO_SURFACE;
+			return Context_ != nullptr && eglMakeCurrent(Display_, surface, surface, Context_) == EGL_TRUE;
+		}
+
+		/// <summary>
+		///		Detach the context from the calling thread, another thread can then take it
+		/// </summary>
+		bool OffscreenContext::release()
+		{
+			return Display_ != nullptr && eglMakeCurrent(Display_, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT) == EGL_TRUE;
+		}
+
+		void OffscreenContext::destroy()
+		{
+			if (Display_ == nullptr)
+				return;
+
+			release();
+
+			if (Surface_ != nullptr)
+				eglDestroySurface(Display_, Surface_);
+
+			if (Context_ != nullptr)
+				eglDestroyContext(Display_, Context_);
+
+			eglTerminate(Display_);
+
+			Display_ = nullptr;
+			Context_ = nullptr;
+			Surface_ = nullptr;
+		}
+
+#else
+
+		bool OffscreenContext::create(int, int)
+		{
+			std::cerr << "Offscreen contexts need EGL : build with CE_USE_EGL." << std::endl;
+			return false;
+		}
+
+		bool OffscreenContext::makeCurrent()
+		{
+			return false;
+		}
+
+		bool OffscreenContext::release()
+		{
+			return false;
+		}
+
+		void OffscreenContext::destroy()
+		{}
+
+#endif
+	}
+}
@@ -0,0 +1,84 @@
+#include <assert.h>
+
+#include "headers/primitive_batch.h"
+
+namespace ce {
+	namespace Graphic {
+
+		/// <summary>
+		///		Constructor. Nothing is allocated : the vertices grow to the largest batch drawn,
+		///		a renderer drawing few primitives never pays for a full batch.
+		/// </summary>
+		PrimitiveBatch::PrimitiveBatch()
+			: Vertices_{}, Primitive_{ BatchPrimitive::TRIANGLES }
+		{}
+
+		/// <summary>
+		///		Tells if the batch must be flushed before appending vertices
+		/// </summary>
+		/// <param name="primitive">Type of the primitive to append</param>
+		/// <param name="vertex_count">Vertices of the primitive</param>
+		/// <returns>True when the type differs or the batch is full</returns>
+		bool PrimitiveBatch::needsFlush(BatchPrimitive primitive, std::size_t vertex_count) const
+		{
+			if (Vertices_.empty())
+				return false;
+
+			return primitive != Primitive_ || Vertices_.size() + vertex_count > CE_BATCH_MAX_VERTICES;
+		}
+
+		/// <summary>
+		///		Append a triangle
+		/// </summary>
+		void PrimitiveBatch::triangle(Core::fVec3 const& p1, Core::fVec3 const& p2, Core::fVec3 const& p3, color<float> const& c)
+		{
+			begin(BatchPrimitive::TRIANGLES);
+			push(p1, c);
+			push(p2, c);
+			push(p3, c);
+		}
+
+		/// <summary>
+		///		Append a quad as two triangles, the points go around the quad
+		/// </summary>
+		void PrimitiveBatch::quad(Core::fVec3 const& p1, Core::fVec3 const& p2, Core::fVec3 const& p3, Core::fVec3 const& p4, color<float> const& c)
+		{
+			begin(BatchPrimitive::TRIANGLES);
+			push(p1, c);
+			push(p2, c);
+			push(p3, c);
+			push(p1, c);
+			push(p3, c);
+			push(p4, c);
+		}
+
+		/// <summary>
+		///		Append a line segment
+		/// </summary>
+		void PrimitiveBatch::line(Core::fVec3 const& p1, Core::fVec3 const& p2, color<float> const& c)
+		{
+			begin(BatchPrimitive::LINES);
+			push(p1, c);
+			push(p2, c);
+		}
+
+		/// <summary>
+		///		Empty the batch
+		/// </summary>
+		void PrimitiveBatch::clear()
+		{
+			Vertices_.clear();
+		}
+
+		void PrimitiveBatch::begin(BatchPrimitive primitive)
+		{
+			assert((Vertices_.empty() || Primitive_ == primitive) && "Flush the batch before changing the primitive type.");
+			Primitive_ = primitive;
+		}
+
+		void PrimitiveBatch::push(Core::fVec3 const& p, color<float> const& c)
+		{
+			Vertices_.push_back(BatchVertex{ p.x, p.y, p.z, c.r, c.g, c.b, c.a });
+		}
+	}
+}
@@ -0,0 +1,257 @@
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+#include "headers/program_cache.h"
+
+namespace ce {
+	namespace Graphic {
+
+		namespace {
+			struct CacheFileHeader {
+				char magic[8];
+				std::uint32_t format;
+				std::uint32_t size;
+			};
+
+			const char* CE_PROGRAM_CACHE_EXTENSION = ".bin";
+		}
+
+		/// <summary>
+		///		Constructor. Create the cache directory if needed.
+		/// </summary>
+		/// <param name="directory">Where the binaries are kept</param>
+		/// <param name="jobs">Runs the file reads and writes, null to run them inline</param>
+		ProgramCache::ProgramCache(std::string directory, Core::JobSystem* jobs)
+			: Directory_{ std::move(directory) },
+			Jobs_{ jobs },
+			Mutex_{},
+			Done_{},
+			Entries_{},
+			Pending_{ 0 },
+			Warming_{ false },
+			FileMutex_{},
+			Versions_{},
+			NextVersion_{ 0 },
+			Hits_{ 0 },
+			Misses_{ 0 }
+		{
+			std::error_code error;
+			std::filesystem::create_directories(Directory_, error);
+
+			if (error)
+				std::cerr << "Can not create the program cache directory " << Directory_ << " : " << error.message() << std::endl;
+		}
+
+		/// <summary>
+		///		Destructor. The jobs still running use this cache.
+		/// </summary>
+		ProgramCache::~ProgramCache()
+		{
+			std::unique_lock<std::mutex> lock{ Mutex_ };
+			Done_.wait(lock, [this] { return Pending_ == 0; });
+		}
+
+		/// <summary>
+		///		Load every binary of the directory in memory, on a worker
+		/// </summary>
+		void ProgramCache::warm()
+		{
+			{
+				std::lock_guard<std::mutex> lock{ Mutex_ };
+				Warming_ = true;
+			}
+
+			run([this]() {
+				std::map<std::uint64_t, Entry> loaded;
+				std::error_code error;
+
+				for (auto const& file : std::filesystem::directory_iterator(Directory_, error))
+				{
+					if (file.path().extension() != CE_PROGRAM_CACHE_EXTENSION)
+						continue;
+
+					Entry entry;
+					auto const key = std::strtoull(file.path().stem().string().c_str(), nullptr, 16);
+
+					if (read(file.path().string(), entry))
+						loaded.emplace(key, std::move(entry));
+				}
+
+				std::lock_guard<std::mutex> lock{ Mutex_ };
+
+				// entries stored meanwhile are newer than the files
+				for (auto& [key, entry] : loaded)
+					Entries_.emplace(key, std::move(entry));
+
+				Warming_ = false;
+			});
+		}
+
+		/// <summary>
+		///		Look a binary up, in memory then on disk. Waits for a warm in progress.
+		/// </summary>
+		/// <param name="key">Hash of the program sources and driver</param>
+		/// <param name="format">Receives the binary format</param>
+		/// <param name="binary">Receives the binary</param>
+		/// <returns>True on a hit</returns>
+		bool ProgramCache::find(std::uint64_t key, GLenum& format, std::vector<char>& binary)
+		{
+			std::unique_lock<std::mutex> lock{ Mutex_ };
+			Done_.wait(lock, [this] { return !Warming_; });
+
+			auto found = Entries_.find(key);
+
+			if (found == Entries_.end())
+			{
+				// not warmed : read the file of this key only
+				Entry entry;
+				if (!read(path(key), entry))
+				{
+					++Misses_;
+					return false;
+				}
+
+				found = Entries_.emplace(key, std::move(entry)).first;
+			}
+
+			++Hits_;
+			format = found->second.format;
+			binary = found->second.binary;
+			return true;
+		}
+
+		/// <summary>
+		///		Keep a binary in memory and write it to disk on a worker
+		/// </summary>
+		void ProgramCache::store(std::uint64_t key, GLenum format, std::vector<char> binary)
+		{
+			Entry entry{ format, std::move(binary) };
+			std::uint64_t version;
+
+			{
+				std::lock_guard<std::mutex> lock{ Mutex_ };
+				Entries_[key] = entry;
+				version = Versions_[key] = ++NextVersion_;
+			}
+
+			run([this, key, version, entry = std::move(entry)]() { write(key, version, entry); });
+		}
+
+		/// <summary>
+		///		Remove a binary from memory and disk, the writes of the key not started yet are dropped
+		/// </summary>
+		void ProgramCache::erase(std::uint64_t key)
+		{
+			{
+				std::lock_guard<std::mutex> lock{ Mutex_ };
+				Entries_.erase(key);
+				Versions_.erase(key);
+			}
+
+			// a write already started finishes first, its file is removed below
+			std::lock_guard<std::mutex> file_lock{ FileMutex_ };
+			std::error_code error;
+			std::filesystem::remove(path(key), error);
+		}
+
+		std::string ProgramCache::path(std::uint64_t key) const
+		{
+			char name[17];
+			std::snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(key));
+			return (std::filesystem::path(Directory_) / (std::string{ name } + CE_PROGRAM_CACHE_EXTENSION)).string();
+		}
+
+		/// <summary>
+		///		Read a cache file, false when it is missing or corrupted
+		/// </summary>
+		bool ProgramCache::read(std::string const& file, Entry& entry) const
+		{
+			std::ifstream in{ file, std::ios::in | std::ios::binary };
+
+			if (!in.is_open())
+				return false;
+
+			CacheFileHeader header;
+			if (!in.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+				std::memcmp(header.magic, CE_PROGRAM_CACHE_MAGIC, sizeof(CE_PROGRAM_CACHE_MAGIC)) != 0)
+				return false;
+
+			// the size on disk is not trusted : it must match the rest of the file exactly
+			auto const start = in.tellg();
+			in.seekg(0, std::ios::end);
+			auto const length = in.tellg() - start;
+			in.seekg(start);
+
+			if (!in || length != static_cast<std::streamoff>(header.size))
+			{
+				std::cerr << "Corrupted program cache file " << file << std::endl;
+				return false;
+			}
+
+			entry.format = header.format;
+			entry.binary.resize(header.size);
+
+			return static_cast<bool>(in.read(entry.binary.data(), header.size));
+		}
+
+		/// <summary>
+		///		Write a cache file, unless the key was stored again or erased since
+		/// </summary>
+		void ProgramCache::write(std::uint64_t key, std::uint64_t version, Entry const& entry)
+		{
+			std::lock_guard<std::mutex> file_lock{ FileMutex_ };
+
+			{
+				std::lock_guard<std::mutex> lock{ Mutex_ };
+				auto const latest = Versions_.find(key);
+
+				if (latest == Versions_.end() || latest->second != version)
+					return;
+			}
+
+			std::ofstream out{ path(key), std::ios::out | std::ios::binary | std::ios::trunc };
+
+			if (!out.is_open())
+			{
+				std::cerr << "Can not write the program cache file " << path(key) << std::endl;
+				return;
+			}
+
+			CacheFileHeader header{};
+			std::memcpy(header.magic, CE_PROGRAM_CACHE_MAGIC, sizeof(CE_PROGRAM_CACHE_MAGIC));
+			header.format = entry.format;
+			header.size = static_cast<std::uint32_t>(entry.binary.size());
+
+			out.write(reinterpret_cast<char const*>(&header), sizeof(header));
+			out.write(entry.binary.data(), entry.binary.size());
+		}
+
+		/// <summary>
+		///		Run a job on the job system, or here without one. The destructor waits for it.
+		/// </summary>
+		void ProgramCache::run(Core::Job job)
+		{
+			{
+				std::lock_guard<std::mutex> lock{ Mutex_ };
+				++Pending_;
+			}
+
+			auto finish = [this, job = std::move(job)]() {
+				job();
+
+				// notified under the lock : the destructor may run as soon as Pending_ reaches 0
+				std::lock_guard<std::mutex> lock{ Mutex_ };
+				--Pending_;
+				Done_.notify_all();
+			};
+
+			if (Jobs_ == nullptr)
+				finish();
+			else
+				Jobs_->submit(std::move(finish));
+		}
+	}
+}
@@ -0,0 +1,105 @@
+#include <algorithm>
+
+#include "headers/render_queue.h"
+
+namespace ce {
+	namespace Graphic {
+
+		/// <summary>
+		///		Build a sort key
+		/// </summary>
+		/// <param name="layer">Draw order of the pass, lower layers are drawn first</param>
+		/// <param name="program">Shader program id</param>
+		/// <param name="material">Material id</param>
+		/// <param name="vao">Vertex array id</param>
+		/// <param name="depth">Normalized view depth, clamped to [0, 1]</param>
+		/// <returns>Key packing the fields</returns>
+		SortKey make_sort_key(std::uint32_t layer, GLuint program, std::uint32_t material, GLuint vao, float depth)
+		{
+			auto field = [](std::uint64_t value, unsigned bits) { return value & ((std::uint64_t{ 1 } << bits) - 1); };
+
+			auto const max_depth = (std::uint64_t{ 1 } << CE_KEY_DEPTH_BITS) - 1;
+			auto const d = static_cast<std::uint64_t>(std::min(std::max(depth, 0.0f), 1.0f) * max_depth);
+
+			SortKey key = field(layer, CE_KEY_LAYER_BITS);
+			key = (key << CE_KEY_PROGRAM_BITS) | field(program, CE_KEY_PROGRAM_BITS);
+			key = (key << CE_KEY_MATERIAL_BITS) | field(material, CE_KEY_MATERIAL_BITS);
+			key = (key << CE_KEY_VAO_BITS) | field(vao, CE_KEY_VAO_BITS);
+			key = (key << CE_KEY_DEPTH_BITS) | d;
+
+			return key;
+		}
+
+		/// <summary>
+		///		Constructor
+		/// </summary>
+		RenderQueue::RenderQueue()
+			: Commands_{}, Transforms_{}, Order_{}, Scratch_{}
+		{}
+
+		/// <summary>
+		///		Keep a transform for the frame
+		/// </summary>
+		/// <returns>Index to put in RenderCommand::transform_index</returns>
+		std::uint32_t RenderQueue::pushTransform(glm::mat4 const& transform)
+		{
+			Transforms_.push_back(transform);
+			return static_cast<std::uint32_t>(Transforms_.size() - 1);
+		}
+
+		/// <summary>
+		///		Order the commands by key. LSD radix sort on bytes, the passes over
+		///		a byte every key shares are skipped, usually the layer and program bytes.
+		/// </summary>
+		void RenderQueue::sort()
+		{
+			auto const n = Commands_.size();
+
+			Order_.resize(n);
+			Scratch_.resize(n);
+
+			for (std::size_t i = 0; i < n; ++i)
+				Order_[i] = Entry{ Commands_[i].key, static_cast<std::uint32_t>(i) };
+
+			if (n < 2)
+				return;
+
+			std::size_t counts[256];
+
+			for (unsigned shift = 0; shift < 64; shift += 8)
+			{
+				std::fill(std::begin(counts), std::end(counts), 0);
+
+				for (auto const& e : Order_)
+					++counts[(e.key >> shift) & 0xFF];
+
+				// every key has the same byte : this pass would not move anything
+				if (counts[(Order_[0].key >> shift) & 0xFF] == n)
+					continue;
+
+				std::size_t offset = 0;
+				for (auto& c : counts)
+				{
+					auto const count = c;
+					c = offset;
+					offset += count;
+				}
+
+				for (auto const& e : Order_)
+					Scratch_[counts[(e.key >> shift) & 0xFF]++] = e;
+
+				Order_.swap(Scratch_);
+			}
+		}
+
+		/// <summary>
+		///		Empty the queue
+		/// </summary>
+		void RenderQueue::clear()
+		{
+			Commands_.clear();
+			Transforms_.clear();
+			Order_.clear();
+		}
+	}
+}
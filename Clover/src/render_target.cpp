@@ -0,0 +1,150 @@
+#include <iostream>
+#include <utility>
+
+#include "headers/render_target.h"
+#include "headers/glFunc.h"
+
+namespace ce {
+	namespace Graphic {
+
+		/// <summary>
+		///		Constructor. The buffers are made by create, once a context exists.
+		/// </summary>
+		RenderTarget::RenderTarget()
+			: Framebuffer_{ 0 },
+			Color_{ 0 },
+			Depth_{ 0 },
+			Width_{ 0 },
+			Height_{ 0 }
+		{}
+
+		/// <summary>
+		///		Destructor
+		/// </summary>
+		RenderTarget::~RenderTarget()
+		{
+			destroy();
+		}
+
+		/// <summary>
+		///		Move constructor
+		/// </summary>
+		RenderTarget::RenderTarget(RenderTarget&& other) noexcept
+			: Framebuffer_{ std::exchange(other.Framebuffer_, 0) },
+			Color_{ std::exchange(other.Color_, 0) },
+			Depth_{ std::exchange(other.Depth_, 0) },
+			Width_{ std::exchange(other.Width_, 0) },
+			Height_{ std::exchange(other.Height_, 0) }
+		{}
+
+		/// <summary>
+		///		Move assignement
+		/// </summary>
+		RenderTarget& RenderTarget::operator=(RenderTarget&& other) noexcept
+		{
+			if (this != &other)
+			{
+				destroy();
+
+				Framebuffer_ = std::exchange(other.Framebuffer_, 0);
+				Color_ = std::exchange(other.Color_, 0);
+				Depth_ = std::exchange(other.Depth_, 0);
+				Width_ = std::exchange(other.Width_, 0);
+				Height_ = std::exchange(other.Height_, 0);
+			}
+
+			return *this;
+		}
+
+		/// <summary>
+		///		Create the framebuffer and its renderbuffers
+		/// </summary>
+		/// <param name="width">Pixels</param>
+		/// <param name="height">Pixels</param>
+		/// <returns>False when the driver rejects the framebuffer</returns>
+		bool RenderTarget::create(int width, int height)
+		{
+			destroy();
+
+			Width_ = width;
+			Height_ = height;
+
+			glGenRenderbuffers(1, &Color_);
+			glBindRenderbuffer(GL_RENDERBUFFER, Color_);
+			glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+
+			glGenRenderbuffers(1, &Depth_);
+			glBindRenderbuffer(GL_RENDERBUFFER, Depth_);
+			glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+			glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+			Framebuffer_ = GLFunc::GenFramebuffer();
+			GLFunc::BindFramebuffer(GL_FRAMEBUFFER, Framebuffer_);
+			glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, Color_);
+			glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, Depth_);
+
+			auto const status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+
+			if (status != GL_FRAMEBUFFER_COMPLETE)
+			{
+				std::cerr << "Incomplete render target, status : " << status << std::endl;
+				destroy();
+				return false;
+			}
+
+			return true;
+		}
+
+		/// <summary>
+		///		Delete the framebuffer and its renderbuffers
+		/// </summary>
+		void RenderTarget::destroy()
+		{
+			if (Framebuffer_ == 0 && Color_ == 0 && Depth_ == 0)
+				return;
+
+			// the context may already be gone at shutdown, the buffers went with it
+			if (GLFunc::IsReady())
+			{
+				if (Framebuffer_ != 0)
+					GLFunc::DeleteFramebuffer(Framebuffer_);
+
+				GLuint const renderbuffers[] = { Color_, Depth_ };
+				glDeleteRenderbuffers(2, renderbuffers);
+			}
+
+			Framebuffer_ = 0;
+			Color_ = 0;
+			Depth_ = 0;
+			Width_ = 0;
+			Height_ = 0;
+		}
+
+		void RenderTarget::bind()
+		{
+			GLFunc::BindFramebuffer(GL_FRAMEBUFFER, Framebuffer_);
+			GLFunc::Viewport(0, 0, Width_, Height_);
+		}
+
+		/// <summary>
+		///		Read the color buffer back to memory
+		/// </summary>
+		/// <param name="image">Receives the RGBA pixels</param>
+		/// <returns>False when the target was not created</returns>
+		bool RenderTarget::read(Image& image)
+		{
+			if (Framebuffer_ == 0)
+				return false;
+
+			image.width = Width_;
+			image.height = Height_;
+			image.pixels.resize(static_cast<std::size_t>(Width_) * Height_ * 4);
+
+			GLFunc::BindFramebuffer(GL_READ_FRAMEBUFFER, Framebuffer_);
+			glPixelStorei(GL_PACK_ALIGNMENT, 4);
+			glReadPixels(0, 0, Width_, Height_, GL_RGBA, GL_UNSIGNED_BYTE, image.pixels.data());
+
+			return true;
+		}
+	}
+}
@@ -0,0 +1,91 @@
+#include "headers/render_thread.h"
+
+namespace ce {
+	namespace Graphic {
+
+		/// <summary>
+		///		Constructor. Start the thread.
+		/// </summary>
+		/// <param name="on_start">Run first on the thread</param>
+		/// <param name="execute">Run on the thread for each submitted frame</param>
+		/// <param name="on_stop">Run last on the thread</param>
+		RenderThread::RenderThread(std::function<void()> on_start, Execute execute, std::function<void()> on_stop)
+			: OnStart_{ std::move(on_start) },
+			Execute_{ std::move(execute) },
+			OnStop_{ std::move(on_stop) },
+			Mutex_{},
+			Signal_{},
+			Pending_{ nullptr },
+			Stop_{ false },
+			Thread_{ &RenderThread::run, this }
+		{}
+
+		/// <summary>
+		///		Destructor. The pending frame is executed before the thread stops.
+		/// </summary>
+		RenderThread::~RenderThread()
+		{
+			{
+				std::lock_guard<std::mutex> lock{ Mutex_ };
+				Stop_ = true;
+			}
+
+			Signal_.notify_all();
+			Thread_.join();
+		}
+
+		/// <summary>
+		///		Hand a recorded frame to the thread
+		/// </summary>
+		/// <param name="frame">Frame to execute</param>
+		void RenderThread::submit(FrameList* frame)
+		{
+			std::unique_lock<std::mutex> lock{ Mutex_ };
+			Signal_.wait(lock, [this] { return Pending_ == nullptr; });
+
+			Pending_ = frame;
+			lock.unlock();
+
+			Signal_.notify_all();
+		}
+
+		/// <summary>
+		///		Wait for the thread to be idle
+		/// </summary>
+		void RenderThread::wait()
+		{
+			std::unique_lock<std::mutex> lock{ Mutex_ };
+			Signal_.wait(lock, [this] { return Pending_ == nullptr; });
+		}
+
+		void RenderThread::run()
+		{
+			OnStart_();
+
+			for (;;)
+			{
+				FrameList* frame;
+				{
+					std::unique_lock<std::mutex> lock{ Mutex_ };
+					Signal_.wait(lock, [this] { return Pending_ != nullptr || Stop_; });
+
+					if (Pending_ == nullptr)
+						break; // stopping and nothing left to execute
+
+					frame = Pending_;
+				}
+
+				Execute_(*frame);
+
+				{
+					std::lock_guard<std::mutex> lock{ Mutex_ };
+					Pending_ = nullptr;
+				}
+
+				Signal_.notify_all();
+			}
+
+			OnStop_();
+		}
+	}
+}
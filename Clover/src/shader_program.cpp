@@ -0,0 +1,148 @@
+#include <assert.h>
+#include <iostream>
+
+#include "headers/shader_program.h"
+#include "headers/glFunc.h"
+
+namespace ce {
+	namespace Graphic {
+
+		namespace {
+			// bytes of one value of a GLSL type in the shadow buffer
+			std::size_t value_size(GLenum type)
+			{
+				switch (type)
+				{
+				case GL_FLOAT_VEC2: return 2 * sizeof(float);
+				case GL_FLOAT_VEC3: return 3 * sizeof(float);
+				case GL_FLOAT_VEC4: return 4 * sizeof(float);
+				case GL_FLOAT_MAT3: return 9 * sizeof(float);
+				case GL_FLOAT_MAT4: return 16 * sizeof(float);
+				default: return sizeof(float); // scalars, bools and samplers
+				}
+			}
+
+			// samplers and bools are set as ints
+			bool is_int_like(GLenum type)
+			{
+				switch (type)
+				{
+				case GL_INT:
+				case GL_BOOL:
+				case GL_SAMPLER_1D:
+				case GL_SAMPLER_2D:
+				case GL_SAMPLER_3D:
+				case GL_SAMPLER_CUBE:
+				case GL_SAMPLER_2D_SHADOW:
+				case GL_SAMPLER_2D_ARRAY:
+					return true;
+				default:
+					return false;
+				}
+			}
+		}
+
+		/// <summary>
+		///		Constructor. Reflect the active uniforms and attributes of a linked program.
+		/// </summary>
+		/// <param name="program_id">Linked program</param>
+		ShaderProgram::ShaderProgram(GLuint program_id)
+			: Program_{ program_id }, Uniforms_{}, Attributes_{}, Values_{}, Uploads_{ 0 }, Skipped_{ 0 }
+		{
+			GLint count = 0, max_length = 0;
+			glGetProgramiv(Program_, GL_ACTIVE_UNIFORMS, &count);
+			glGetProgramiv(Program_, GL_ACTIVE_UNIFORM_MAX_LENGTH, &max_length);
+
+			std::vector<char> name(max_length + 1);
+			std::size_t offset = 0;
+
+			for (GLint i = 0; i < count; ++i)
+			{
+				GLsizei length = 0;
+				GLint size = 0;
+				GLenum type = 0;
+				glGetActiveUniform(Program_, i, static_cast<GLsizei>(name.size()), &length, &size, &type, name.data());
+
+				auto const location = glGetUniformLocation(Program_, name.data());
+				if (location < 0)
+					continue; // uniform block member, not set through glUniform*
+
+				std::string n{ name.data(), static_cast<std::size_t>(length) };
+				if (n.size() > 3 && n.compare(n.size() - 3, 3, "[0]") == 0)
+					n.resize(n.size() - 3);
+
+				Uniforms_.push_back(UniformInfo{ std::move(n), location, type, size, offset, value_size(type), false });
+				offset += value_size(type);
+			}
+
+			Values_.resize(offset);
+
+			glGetProgramiv(Program_, GL_ACTIVE_ATTRIBUTES, &count);
+			glGetProgramiv(Program_, GL_ACTIVE_ATTRIBUTE_MAX_LENGTH, &max_length);
+			name.assign(max_length + 1, '\0');
+
+			for (GLint i = 0; i < count; ++i)
+			{
+				GLsizei length = 0;
+				GLint size = 0;
+				GLenum type = 0;
+				glGetActiveAttrib(Program_, i, static_cast<GLsizei>(name.size()), &length, &size, &type, name.data());
+
+				std::string n{ name.data(), static_cast<std::size_t>(length) };
+				auto const location = glGetAttribLocation(Program_, n.c_str());
+				Attributes_.push_back(AttributeInfo{ std::move(n), location, type });
+			}
+
+#ifdef CE_VERBOSE
+			std::cout << "Program " << Program_ << " : " << Uniforms_.size() << " uniforms, " << Attributes_.size() << " attributes" << std::endl;
+#endif
+		}
+
+		/// <summary>
+		///		Location of an active attribute
+		/// </summary>
+		GLint ShaderProgram::attribute(std::string const& name) const
+		{
+			for (auto const& a : Attributes_)
+				if (a.name == name)
+					return a.location;
+
+			return -1;
+		}
+
+		std::int32_t ShaderProgram::find_uniform(std::string const& name, GLenum type) const
+		{
+			for (std::size_t i = 0; i < Uniforms_.size(); ++i)
+			{
+				if (Uniforms_[i].name != name)
+					continue;
+
+				auto const matches = Uniforms_[i].type == type || (type == GL_INT && is_int_like(Uniforms_[i].type));
+				assert(matches && "Uniform type does not match the shader declaration.");
+
+				// release builds : an invalid handle rather than writes of the wrong size
+				if (!matches)
+				{
+					std::cerr << "Uniform " << name << " of program " << Program_ << " does not have the requested type" << std::endl;
+					return -1;
+				}
+
+				return static_cast<std::int32_t>(i);
+			}
+
+			return -1;
+		}
+
+		void ShaderProgram::use() const
+		{
+			GLFunc::UseShader(Program_);
+		}
+
+		void ShaderProgram::upload(GLint location, float value) { glUniform1f(location, value); }
+		void ShaderProgram::upload(GLint location, int value) { glUniform1i(location, value); }
+		void ShaderProgram::upload(GLint location, glm::vec2 const& value) { glUniform2fv(location, 1, &value[0]); }
+		void ShaderProgram::upload(GLint location, glm::vec3 const& value) { glUniform3fv(location, 1, &value[0]); }
+		void ShaderProgram::upload(GLint location, glm::vec4 const& value) { glUniform4fv(location, 1, &value[0]); }
+		void ShaderProgram::upload(GLint location, glm::mat4 const& value) { glUniformMatrix4fv(location, 1, GL_FALSE, &value[0][0]); }
+	}
+}
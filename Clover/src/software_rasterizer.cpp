@@ -0,0 +1,610 @@
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <iostream>
+
+#include "headers/software_rasterizer.h"
+
+// widest instruction set the setup and the pixel loop are compiled for. Define CE_NO_SIMD to keep the scalar code.
+#if !defined(CE_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define CE_RASTER_SSE
+#include <immintrin.h>
+#endif
+
+namespace ce {
+	namespace Graphic {
+
+		namespace {
+
+			// the setup is written once for any lane type : float, or Float4 for four triangles at a time
+			inline float splat(float value, float) { return value; }
+			inline float load(float const* p, float) { return *p; }
+			inline void store(float* p, float value) { *p = value; }
+			inline float vmin(float a, float b) { return std::min(a, b); }
+			inline float vmax(float a, float b) { return std::max(a, b); }
+			inline float sign_of(float value) { return std::signbit(value) ? -1.0f : 1.0f; }
+
+#ifdef CE_RASTER_SSE
+			struct Float4 {
+				__m128 v;
+			};
+
+			inline Float4 operator+(Float4 a, Float4 b) { return { _mm_add_ps(a.v, b.v) }; }
+			inline Float4 operator-(Float4 a, Float4 b) { return { _mm_sub_ps(a.v, b.v) }; }
+			inline Float4 operator*(Float4 a, Float4 b) { return { _mm_mul_ps(a.v, b.v) }; }
+			inline Float4 operator/(Float4 a, Float4 b) { return { _mm_div_ps(a.v, b.v) }; }
+
+			inline Float4 splat(float value, Float4) { return { _mm_set1_ps(value) }; }
+			inline Float4 load(float const* p, Float4) { return { _mm_loadu_ps(p) }; }
+			inline void store(float* p, Float4 value) { _mm_storeu_ps(p, value.v); }
+			inline Float4 vmin(Float4 a, Float4 b) { return { _mm_min_ps(a.v, b.v) }; }
+			inline Float4 vmax(Float4 a, Float4 b) { return { _mm_max_ps(a.v, b.v) }; }
+
+			// -1 when the sign bit is set, as std::signbit
+			inline Float4 sign_of(Float4 value) { return { _mm_or_ps(_mm_and_ps(value.v, _mm_set1_ps(-0.0f)), _mm_set1_ps(1.0f)) }; }
+#endif
+
+			/// <summary>
+			///		Planes of a lane of triangles, the same operations in the same order for every lane type
+			///		so the SIMD and the scalar setups give the same bits
+			/// </summary>
+			template<class V>
+			struct SetupLanes {
+				V area;
+				V edges[3][3];
+				V depth[3];
+				V rgba[4][3];
+				V bounds[4];
+			};
+
+			template<class V, class S>
+			void setup_lanes(S const& staged, std::size_t i, SetupLanes<V>& out)
+			{
+				V const tag{};
+				V x[3], y[3], z[3];
+
+				for (int v = 0; v < 3; ++v)
+				{
+					x[v] = load(&staged.x[v][i], tag);
+					y[v] = load(&staged.y[v][i], tag);
+					z[v] = load(&staged.z[v][i], tag);
+				}
+
+				// twice the signed area, the edges are flipped so the inside is positive for both windings
+				auto const area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+				auto const sign = sign_of(area);
+				out.area = area * sign;
+
+				auto const inv_area = splat(1.0f, tag) / out.area;
+
+				// edge e is opposite to vertex e, its value divided by the area is the barycentric of e
+				for (int e = 0; e < 3; ++e)
+				{
+					auto const a = (e + 1) % 3;
+					auto const b = (e + 2) % 3;
+					out.edges[e][0] = (y[a] - y[b]) * sign;
+					out.edges[e][1] = (x[b] - x[a]) * sign;
+					out.edges[e][2] = (x[a] * y[b] - x[b] * y[a]) * sign;
+				}
+
+				auto plane = [&](V const values[3], V (&result)[3]) {
+					for (int k = 0; k < 3; ++k)
+						result[k] = (values[0] * out.edges[0][k] + values[1] * out.edges[1][k] + values[2] * out.edges[2][k]) * inv_area;
+				};
+
+				plane(z, out.depth);
+
+				for (int c = 0; c < 4; ++c)
+				{
+					V const values[3] = { load(&staged.rgba[0][c][i], tag), load(&staged.rgba[1][c][i], tag), load(&staged.rgba[2][c][i], tag) };
+					plane(values, out.rgba[c]);
+				}
+
+				out.bounds[0] = vmin(vmin(x[0], x[1]), x[2]);
+				out.bounds[1] = vmin(vmin(y[0], y[1]), y[2]);
+				out.bounds[2] = vmax(vmax(x[0], x[1]), x[2]);
+				out.bounds[3] = vmax(vmax(y[0], y[1]), y[2]);
+			}
+
+			std::uint32_t pack(float r, float g, float b, float a)
+			{
+				auto byte = [](float value) {
+					return static_cast<std::uint32_t>(std::min(std::max(value, 0.0f), 1.0f) * 255.0f + 0.5f);
+				};
+
+				return byte(r) | byte(g) << 8 | byte(b) << 16 | byte(a) << 24;
+			}
+		}
+
+		/// <summary>
+		///		Constructor
+		/// </summary>
+		/// <param name="width">Framebuffer width in pixels</param>
+		/// <param name="height">Framebuffer height in pixels</param>
+		SoftwareRasterizer::SoftwareRasterizer(int width, int height)
+			: Width_{ width },
+			Height_{ height },
+			TilesX_{ (width + CE_RASTER_TILE_SIZE - 1) / CE_RASTER_TILE_SIZE },
+			TilesY_{ (height + CE_RASTER_TILE_SIZE - 1) / CE_RASTER_TILE_SIZE },
+			Color_(static_cast<std::size_t>(width) * height, 0),
+			Depth_(static_cast<std::size_t>(width) * height, 1.0f),
+			ClearColor_{ 0 },
+			Staged_{},
+			Setups_{},
+			Bins_(static_cast<std::size_t>(TilesX_) * TilesY_),
+			Meshes_{},
+			Transformed_{},
+			Triangles_{ 0 },
+			Jobs_{ nullptr },
+			Work_{ std::make_shared<TileWork>() },
+			Generation_{ 0 }
+		{
+			Work_->cursor = 0;
+			Work_->done = 0;
+		}
+
+		void SoftwareRasterizer::setClearColor(color<float> clear_color)
+		{
+			ClearColor_ = pack(clear_color.r, clear_color.g, clear_color.b, clear_color.a);
+		}
+
+		/// <summary>
+		///		Clear the color and the depth, after the triangles already drawn
+		/// </summary>
+		void SoftwareRasterizer::clear()
+		{
+			flush();
+
+			std::fill(Color_.begin(), Color_.end(), ClearColor_);
+			std::fill(Depth_.begin(), Depth_.end(), 1.0f);
+		}
+
+		/// <summary>
+		///		Keep a copy of a mesh as a triangle list
+		/// </summary>
+		void SoftwareRasterizer::addMesh(MeshData const& data)
+		{
+			std::vector<Core::fVec3> triangles;
+
+			if (data.indices == nullptr)
+				triangles.assign(data.positions, data.positions + data.vertex_count);
+			else
+			{
+				triangles.reserve(data.index_count);
+
+				for (std::size_t i = 0; i < data.index_count; ++i)
+				{
+					auto const index = data.index_type == GL_UNSIGNED_SHORT
+						? static_cast<GLushort const*>(data.indices)[i]
+						: static_cast<GLuint const*>(data.indices)[i];
+
+					// keep the id in step with the MeshRegistry, drawn as nothing
+					if (index >= data.vertex_count)
+					{
+						std::cerr << "Mesh " << Meshes_.size() << " : index " << i << " is out of the vertex range" << std::endl;
+						triangles.clear();
+						break;
+					}
+
+					triangles.push_back(data.positions[index]);
+				}
+			}
+
+			Meshes_.push_back(std::move(triangles));
+		}
+
+		/// <summary>
+		///		Transform, clip and bin a batch of triangles
+		/// </summary>
+		void SoftwareRasterizer::drawBatch(BatchVertex const* vertices, std::size_t count, glm::mat4 const& mvp)
+		{
+			Transformed_.resize(count);
+
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				auto const& v = vertices[i];
+				Transformed_[i] = Vertex{ mvp * glm::vec4(v.x, v.y, v.z, 1.0f), color<float>{ v.r, v.g, v.b, v.a } };
+			}
+
+			stageTriangles(Transformed_.data(), count);
+			setup();
+		}
+
+		/// <summary>
+		///		Transform, clip and bin every instance of a mesh. The instances are set up together
+		/// </summary>
+		void SoftwareRasterizer::drawInstances(MeshId mesh, glm::mat4 const& view_projection, InstanceData const* instances, std::size_t count)
+		{
+			if (mesh >= Meshes_.size())
+				return;
+
+			auto const& positions = Meshes_[mesh];
+			Transformed_.resize(positions.size());
+
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				auto const mvp = view_projection * instances[i].model;
+
+				for (std::size_t v = 0; v < positions.size(); ++v)
+					Transformed_[v] = Vertex{ mvp * glm::vec4(positions[v].x, positions[v].y, positions[v].z, 1.0f), instances[i].tint };
+
+				stageTriangles(Transformed_.data(), positions.size());
+			}
+
+			setup();
+		}
+
+		/// <summary>
+		///		Rasterize every tile touched since the last flush, on the job system and on this thread
+		/// </summary>
+		void SoftwareRasterizer::flush()
+		{
+			if (Setups_.empty())
+				return;
+
+			auto const tiles = Bins_.size();
+			auto const generation = ++Generation_;
+
+			{
+				std::lock_guard<std::mutex> lock{ Work_->mutex };
+				Work_->done = 0;
+			}
+
+			// the helpers of older flushes see another generation and take nothing
+			Work_->cursor.store(static_cast<std::uint64_t>(generation) << 32, std::memory_order_release);
+
+			auto const helpers = Jobs_ != nullptr ? std::min(Jobs_->workerCount(), tiles - 1) : 0;
+
+			for (std::size_t i = 0; i < helpers; ++i)
+				Jobs_->submit([this, work = Work_, generation, tiles]() {
+					rasterizeTiles(this, *work, generation, tiles);
+				});
+
+			rasterizeTiles(this, *Work_, generation, tiles);
+
+			// only the tiles taken by running helpers are waited for, not the helpers still queued
+			std::unique_lock<std::mutex> lock{ Work_->mutex };
+			Work_->finished.wait(lock, [this, tiles]() { return Work_->done == tiles; });
+
+			for (auto& bin : Bins_)
+				bin.clear();
+
+			Setups_.clear();
+		}
+
+		/// <summary>
+		///		Take the tiles of a flush one at a time until none is left, a thread finishing early takes the next one
+		/// </summary>
+		/// <param name="raster">Only used once a tile is taken : its flush waits for that tile, so it is alive</param>
+		/// <param name="work">Cursor of the rasterizer, kept alive by the caller</param>
+		/// <param name="generation">Flush the caller works for, nothing is taken from another one</param>
+		/// <param name="tiles">Tile count</param>
+		void SoftwareRasterizer::rasterizeTiles(SoftwareRasterizer* raster, TileWork& work, std::uint32_t generation, std::size_t tiles)
+		{
+			std::size_t done = 0;
+
+			auto cursor = work.cursor.load(std::memory_order_acquire);
+
+			while (static_cast<std::uint32_t>(cursor >> 32) == generation && (cursor & 0xffffffffu) < tiles)
+			{
+				if (!work.cursor.compare_exchange_weak(cursor, cursor + 1, std::memory_order_acq_rel))
+					continue;
+
+				raster->rasterizeTile(static_cast<std::size_t>(cursor & 0xffffffffu));
+				++done;
+				cursor = work.cursor.load(std::memory_order_acquire);
+			}
+
+			if (done == 0)
+				return;
+
+			// notify under the lock : flush may return and the rasterizer go as soon as every tile is counted
+			std::lock_guard<std::mutex> lock{ work.mutex };
+			work.done += done;
+			work.finished.notify_all();
+		}
+
+		/// <summary>
+		///		Copy the color buffer
+		/// </summary>
+		bool SoftwareRasterizer::read(Image& image) const
+		{
+			image.width = Width_;
+			image.height = Height_;
+			image.pixels.resize(Color_.size() * 4);
+
+			for (std::size_t i = 0; i < Color_.size(); ++i)
+				for (int c = 0; c < 4; ++c)
+					image.pixels[i * 4 + c] = static_cast<unsigned char>(Color_[i] >> (8 * c));
+
+			return true;
+		}
+
+		void SoftwareRasterizer::Staged::clear()
+		{
+			for (int v = 0; v < 3; ++v)
+			{
+				x[v].clear();
+				y[v].clear();
+				z[v].clear();
+
+				for (int c = 0; c < 4; ++c)
+					rgba[v][c].clear();
+			}
+		}
+
+		/// <summary>
+		///		Clip a triangle list against the near plane and stage what is left in screen space
+		/// </summary>
+		void SoftwareRasterizer::stageTriangles(Vertex const* vertices, std::size_t count)
+		{
+			for (std::size_t i = 0; i + 2 < count; i += 3)
+			{
+				auto const v = vertices + i;
+
+				// distance to the near plane z = -w, inside when positive
+				float const d[3] = { v[0].position.z + v[0].position.w, v[1].position.z + v[1].position.w, v[2].position.z + v[2].position.w };
+
+				if (d[0] < 0.0f && d[1] < 0.0f && d[2] < 0.0f)
+					continue;
+
+				if (d[0] >= 0.0f && d[1] >= 0.0f && d[2] >= 0.0f)
+				{
+					stage(v[0], v[1], v[2]);
+					continue;
+				}
+
+				// one plane cuts a triangle into at most a quad
+				Vertex polygon[4];
+				auto n = 0;
+
+				for (int k = 0; k < 3; ++k)
+				{
+					auto const next = (k + 1) % 3;
+
+					if (d[k] >= 0.0f)
+						polygon[n++] = v[k];
+
+					if ((d[k] >= 0.0f) != (d[next] >= 0.0f))
+					{
+						auto const t = d[k] / (d[k] - d[next]);
+						auto const& a = v[k].tint;
+						auto const& b = v[next].tint;
+
+						polygon[n++] = Vertex{
+							v[k].position + (v[next].position - v[k].position) * t,
+							color<float>{ a.r + (b.r - a.r) * t, a.g + (b.g - a.g) * t, a.b + (b.b - a.b) * t, a.a + (b.a - a.a) * t } };
+					}
+				}
+
+				for (int k = 1; k + 1 < n; ++k)
+					stage(polygon[0], polygon[k], polygon[k + 1]);
+			}
+		}
+
+		/// <summary>
+		///		Perspective divide and viewport transform. The depth goes to [0, 1] as with glDepthRange(0, 1)
+		/// </summary>
+		void SoftwareRasterizer::stage(Vertex const& a, Vertex const& b, Vertex const& c)
+		{
+			Vertex const* vertices[3] = { &a, &b, &c };
+
+			for (int v = 0; v < 3; ++v)
+			{
+				auto const& p = vertices[v]->position;
+				auto const inv_w = 1.0f / p.w;
+
+				Staged_.x[v].push_back((p.x * inv_w * 0.5f + 0.5f) * Width_);
+				Staged_.y[v].push_back((p.y * inv_w * 0.5f + 0.5f) * Height_);
+				Staged_.z[v].push_back(p.z * inv_w * 0.5f + 0.5f);
+
+				auto const& tint = vertices[v]->tint;
+				Staged_.rgba[v][0].push_back(tint.r);
+				Staged_.rgba[v][1].push_back(tint.g);
+				Staged_.rgba[v][2].push_back(tint.b);
+				Staged_.rgba[v][3].push_back(tint.a);
+			}
+		}
+
+		/// <summary>
+		///		Compute the planes of the staged triangles, four at a time when SIMD is available, then bin them
+		/// </summary>
+		void SoftwareRasterizer::setup()
+		{
+			auto const count = Staged_.size();
+			std::size_t i = 0;
+
+			// lanes are scattered to the setups one by one, dropping the degenerate and off screen triangles
+			auto scatter = [this](auto const& lanes, int lane_count) {
+				float area[4], edges[3][3][4], depth[3][4], rgba[4][3][4], bounds[4][4];
+
+				store(area, lanes.area);
+				for (int k = 0; k < 3; ++k)
+				{
+					for (int e = 0; e < 3; ++e)
+						store(edges[e][k], lanes.edges[e][k]);
+
+					store(depth[k], lanes.depth[k]);
+
+					for (int c = 0; c < 4; ++c)
+						store(rgba[c][k], lanes.rgba[c][k]);
+				}
+				for (int b = 0; b < 4; ++b)
+					store(bounds[b], lanes.bounds[b]);
+
+				for (int l = 0; l < lane_count; ++l)
+				{
+					// zero area, or a NaN from a vertex on the eye plane
+					if (!(area[l] > 0.0f))
+						continue;
+
+					if (bounds[2][l] < 0.0f || bounds[3][l] < 0.0f || bounds[0][l] >= Width_ || bounds[1][l] >= Height_)
+						continue;
+
+					Setup triangle{};
+
+					for (int e = 0; e < 3; ++e)
+					{
+						for (int k = 0; k < 3; ++k)
+							triangle.edges[e][k] = edges[e][k][l];
+
+						// shared edges have opposite coefficients : exactly one of the two triangles owns the pixels on it
+						triangle.owns[e] = triangle.edges[e][0] > 0.0f || (triangle.edges[e][0] == 0.0f && triangle.edges[e][1] < 0.0f);
+					}
+
+					for (int k = 0; k < 3; ++k)
+					{
+						triangle.depth[k] = depth[k][l];
+						for (int c = 0; c < 4; ++c)
+							triangle.rgba[c][k] = rgba[c][k][l];
+					}
+
+					// clamped before the conversion, a vertex near the eye plane lands very far away
+					triangle.bounds[0] = static_cast<int>(std::max(0.0f, std::floor(bounds[0][l])));
+					triangle.bounds[1] = static_cast<int>(std::max(0.0f, std::floor(bounds[1][l])));
+					triangle.bounds[2] = static_cast<int>(std::min(static_cast<float>(Width_ - 1), std::ceil(bounds[2][l])));
+					triangle.bounds[3] = static_cast<int>(std::min(static_cast<float>(Height_ - 1), std::ceil(bounds[3][l])));
+
+					bin(triangle);
+				}
+			};
+
+#ifdef CE_RASTER_SSE
+			for (; i + 4 <= count; i += 4)
+			{
+				SetupLanes<Float4> lanes;
+				setup_lanes(Staged_, i, lanes);
+				scatter(lanes, 4);
+			}
+#endif
+
+			for (; i < count; ++i)
+			{
+				SetupLanes<float> lanes;
+				setup_lanes(Staged_, i, lanes);
+				scatter(lanes, 1);
+			}
+
+			Triangles_ += count;
+			Staged_.clear();
+		}
+
+		/// <summary>
+		///		Append a triangle to the bins of the tiles under its bounds
+		/// </summary>
+		void SoftwareRasterizer::bin(Setup const& triangle)
+		{
+			auto const index = static_cast<std::uint32_t>(Setups_.size());
+			Setups_.push_back(triangle);
+
+			for (auto ty = triangle.bounds[1] / CE_RASTER_TILE_SIZE; ty <= triangle.bounds[3] / CE_RASTER_TILE_SIZE; ++ty)
+				for (auto tx = triangle.bounds[0] / CE_RASTER_TILE_SIZE; tx <= triangle.bounds[2] / CE_RASTER_TILE_SIZE; ++tx)
+					Bins_[static_cast<std::size_t>(ty) * TilesX_ + tx].push_back(index);
+		}
+
+		/// <summary>
+		///		Draw the triangles of a tile in submission order. Only this thread writes the tile pixels
+		/// </summary>
+		void SoftwareRasterizer::rasterizeTile(std::size_t tile)
+		{
+			auto const& bin = Bins_[tile];
+
+			if (bin.empty())
+				return;
+
+			auto const tile_x = static_cast<int>(tile % TilesX_) * CE_RASTER_TILE_SIZE;
+			auto const tile_y = static_cast<int>(tile / TilesX_) * CE_RASTER_TILE_SIZE;
+
+			for (auto const index : bin)
+			{
+				auto const& t = Setups_[index];
+
+				auto const x0 = std::max(t.bounds[0], tile_x);
+				auto const y0 = std::max(t.bounds[1], tile_y);
+				auto const x1 = std::min(t.bounds[2], std::min(tile_x + CE_RASTER_TILE_SIZE, Width_) - 1);
+				auto const y1 = std::min(t.bounds[3], std::min(tile_y + CE_RASTER_TILE_SIZE, Height_) - 1);
+
+				for (auto y = y0; y <= y1; ++y)
+				{
+					// the part of the planes constant along the row
+					auto const py = static_cast<float>(y) + 0.5f;
+					float const row[3] = { t.edges[0][1] * py + t.edges[0][2], t.edges[1][1] * py + t.edges[1][2], t.edges[2][1] * py + t.edges[2][2] };
+					auto const depth_row = t.depth[1] * py + t.depth[2];
+					float const rgba_row[4] = { t.rgba[0][1] * py + t.rgba[0][2], t.rgba[1][1] * py + t.rgba[1][2],
+						t.rgba[2][1] * py + t.rgba[2][2], t.rgba[3][1] * py + t.rgba[3][2] };
+
+					auto x = x0;
+
+#ifdef CE_RASTER_SSE
+					auto const zero = _mm_setzero_ps();
+					auto const lane_offsets = _mm_set_ps(3.5f, 2.5f, 1.5f, 0.5f);
+
+					for (; x + 3 <= x1; x += 4)
+					{
+						auto const px = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), lane_offsets);
+						auto covered = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+						for (int e = 0; e < 3; ++e)
+						{
+							auto const value = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(t.edges[e][0]), px), _mm_set1_ps(row[e]));
+							auto const owns = t.owns[e] ? _mm_castsi128_ps(_mm_set1_epi32(-1)) : zero;
+							auto const inside = _mm_or_ps(_mm_cmpgt_ps(value, zero), _mm_and_ps(_mm_cmpeq_ps(value, zero), owns));
+							covered = _mm_and_ps(covered, inside);
+						}
+
+						if (_mm_movemask_ps(covered) == 0)
+							continue;
+
+						auto const pixel = static_cast<std::size_t>(y) * Width_ + x;
+						auto const z = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(t.depth[0]), px), _mm_set1_ps(depth_row));
+						auto const stored = _mm_loadu_ps(&Depth_[pixel]);
+						auto const pass = _mm_and_ps(covered, _mm_and_ps(_mm_cmpge_ps(z, zero), _mm_cmple_ps(z, stored)));
+						auto const mask = _mm_movemask_ps(pass);
+
+						if (mask == 0)
+							continue;
+
+						_mm_storeu_ps(&Depth_[pixel], _mm_or_ps(_mm_and_ps(pass, z), _mm_andnot_ps(pass, stored)));
+
+						float rgba[4][4];
+						for (int c = 0; c < 4; ++c)
+							_mm_storeu_ps(rgba[c], _mm_add_ps(_mm_mul_ps(_mm_set1_ps(t.rgba[c][0]), px), _mm_set1_ps(rgba_row[c])));
+
+						for (int l = 0; l < 4; ++l)
+							if (mask & (1 << l))
+								Color_[pixel + l] = pack(rgba[0][l], rgba[1][l], rgba[2][l], rgba[3][l]);
+					}
+#endif
+
+					for (; x <= x1; ++x)
+						shade(t, x, y, row, depth_row, rgba_row);
+				}
+			}
+		}
+
+		/// <summary>
+		///		Coverage, depth test and color of one pixel
+		/// </summary>
+		void SoftwareRasterizer::shade(Setup const& t, int x, int y, float const row[3], float depth_row, float const rgba_row[4])
+		{
+			auto const px = static_cast<float>(x) + 0.5f;
+
+			for (int e = 0; e < 3; ++e)
+			{
+				auto const value = t.edges[e][0] * px + row[e];
+				if (!(value > 0.0f || (value == 0.0f && t.owns[e])))
+					return;
+			}
+
+			auto const pixel = static_cast<std::size_t>(y) * Width_ + x;
+			auto const z = t.depth[0] * px + depth_row;
+
+			if (!(z >= 0.0f && z <= Depth_[pixel]))
+				return;
+
+			Depth_[pixel] = z;
+			Color_[pixel] = pack(t.rgba[0][0] * px + rgba_row[0], t.rgba[1][0] * px + rgba_row[1],
+				t.rgba[2][0] * px + rgba_row[2], t.rgba[3][0] * px + rgba_row[3]);
+		}
+	}
+}
@@ -0,0 +1,245 @@
+#include <assert.h>
+#include <iostream>
+
+#include "headers/stream_ring.h"
+#include "headers/glFunc.h"
+
+namespace ce {
+	namespace Graphic {
+
+		/// <summary>
+		///		Constructor. The buffer is created by init, once a context exists.
+		/// </summary>
+		StreamRing::StreamRing()
+			: Buffer_{ 0 }, Target_{ GL_ARRAY_BUFFER }, SegmentSize_{ 0 }, Mapped_{ nullptr },
+			Fences_{}, Segment_{ 0 }, Head_{ 0 }, RangeMapped_{ false }, Stalls_{ 0 }
+		{}
+
+		/// <summary>
+		///		Destructor
+		/// </summary>
+		StreamRing::~StreamRing()
+		{
+			release();
+		}
+
+		/// <summary>
+		///		Move constructor
+		/// </summary>
+		/// <param name="other">Ring to move, left without buffer</param>
+		StreamRing::StreamRing(StreamRing&& other) noexcept
+			: StreamRing{}
+		{
+			*this = std::move(other);
+		}
+
+		/// <summary>
+		///		Move assignement
+		/// </summary>
+		/// <param name="other">Ring to move, left without buffer</param>
+		StreamRing& StreamRing::operator=(StreamRing&& other) noexcept
+		{
+			if (this != &other)
+			{
+				release();
+
+				Buffer_ = other.Buffer_;
+				Target_ = other.Target_;
+				SegmentSize_ = other.SegmentSize_;
+				Mapped_ = other.Mapped_;
+				Segment_ = other.Segment_;
+				Head_ = other.Head_;
+				RangeMapped_ = other.RangeMapped_;
+				Stalls_ = other.Stalls_;
+
+				for (std::size_t i = 0; i < CE_STREAM_RING_SEGMENTS; ++i)
+				{
+					Fences_[i] = other.Fences_[i];
+					other.Fences_[i] = nullptr;
+				}
+
+				other.Buffer_ = 0;
+				other.Mapped_ = nullptr;
+				other.SegmentSize_ = 0;
+				other.RangeMapped_ = false;
+			}
+
+			return *this;
+		}
+
+		/// <summary>
+		///		Create and map the buffer
+		/// </summary>
+		/// <param name="target">Binding point used to write the buffer</param>
+		/// <param name="segment_size">Bytes available to one frame</param>
+		void StreamRing::init(GLenum target, GLsizeiptr segment_size)
+		{
+			release();
+
+			Target_ = target;
+			SegmentSize_ = segment_size;
+			Segment_ = 0;
+			Head_ = 0;
+
+			auto const total = segment_size * static_cast<GLsizeiptr>(CE_STREAM_RING_SEGMENTS);
+
+			Buffer_ = GLFunc::GenBuffer();
+			GLFunc::BindBuffer(Target_, Buffer_);
+
+			if (GLEW_ARB_buffer_storage)
+			{
+				// immutable storage, mapped for the whole life of the buffer
+				GLbitfield const flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+				glBufferStorage(Target_, total, nullptr, flags);
+				Mapped_ = static_cast<unsigned char*>(glMapBufferRange(Target_, 0, total, flags));
+			}
+
+			if (Mapped_ == nullptr)
+			{
+				GLFunc::BufferData(Target_, total, nullptr, GL_STREAM_DRAW);
+			}
+
+#ifdef CE_VERBOSE
+			std::cout << "Stream ring of " << total << " bytes, " << (Mapped_ != nullptr ? "persistent" : "orphaning") << std::endl;
+#endif
+		}
+
+		/// <summary>
+		///		Unmap and delete the buffer
+		/// </summary>
+		void StreamRing::release()
+		{
+			// the context may already be gone at shutdown, the buffer went with it
+			if (Buffer_ != 0 && GLFunc::IsReady())
+			{
+				if (Mapped_ != nullptr || RangeMapped_)
+				{
+					GLFunc::BindBuffer(Target_, Buffer_);
+					glUnmapBuffer(Target_);
+				}
+
+				for (auto& fence : Fences_)
+					if (fence != nullptr)
+						glDeleteSync(fence);
+
+				GLFunc::DeleteBuffer(Buffer_);
+			}
+
+			for (auto& fence : Fences_)
+				fence = nullptr;
+
+			Buffer_ = 0;
+			Mapped_ = nullptr;
+			RangeMapped_ = false;
+		}
+
+		/// <summary>
+		///		Take space in the current segment, moving to the next one when it is full
+		/// </summary>
+		/// <param name="size">Bytes to write</param>
+		/// <param name="alignment">Offset alignment, the vertex size to draw from the offset</param>
+		/// <returns>Where to write, data is null when the size exceeds a segment</returns>
+		StreamAllocation StreamRing::allocate(GLsizeiptr size, GLsizeiptr alignment)
+		{
+			assert(Buffer_ != 0 && "StreamRing::init must be called first.");
+			assert(!RangeMapped_ && "The previous allocation was not committed.");
+
+			if (size > SegmentSize_ - alignment)
+				return StreamAllocation{ nullptr, 0, 0 };
+
+			auto align = [alignment](GLintptr offset) { return (offset + alignment - 1) / alignment * alignment; };
+
+			auto base = static_cast<GLintptr>(Segment_) * SegmentSize_;
+			auto offset = align(base + Head_);
+
+			if (offset + size > base + SegmentSize_)
+			{
+				next_segment();
+				base = static_cast<GLintptr>(Segment_) * SegmentSize_;
+				offset = align(base);
+			}
+
+			Head_ = offset + size - base;
+
+			if (Mapped_ != nullptr)
+				return StreamAllocation{ Mapped_ + offset, offset, size };
+
+			// this range was not used since the last orphaning : no need to synchronize
+			GLFunc::BindBuffer(Target_, Buffer_);
+			auto data = glMapBufferRange(Target_, offset, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+			RangeMapped_ = data != nullptr;
+
+			return StreamAllocation{ data, offset, size };
+		}
+
+		/// <summary>
+		///		Tell if an allocation stays in the current segment
+		/// </summary>
+		bool StreamRing::fits(GLsizeiptr size, GLsizeiptr alignment) const
+		{
+			auto const base = static_cast<GLintptr>(Segment_) * SegmentSize_;
+			auto const offset = (base + Head_ + alignment - 1) / alignment * alignment;
+
+			return offset + size <= base + SegmentSize_;
+		}
+
+		/// <summary>
+		///		Finish writing an allocation. Nothing to do for coherent persistent mappings.
+		/// </summary>
+		void StreamRing::commit(StreamAllocation const& allocation)
+		{
+			if (!RangeMapped_ || allocation.data == nullptr)
+				return;
+
+			GLFunc::BindBuffer(Target_, Buffer_);
+			glUnmapBuffer(Target_);
+			RangeMapped_ = false;
+		}
+
+		/// <summary>
+		///		Close the segment of the frame
+		/// </summary>
+		void StreamRing::endFrame()
+		{
+			if (Buffer_ != 0 && Head_ > 0)
+				next_segment();
+		}
+
+		void StreamRing::next_segment()
+		{
+			if (Mapped_ != nullptr)
+			{
+				// the GPU is done with this segment once the commands issued so far are done
+				Fences_[Segment_] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+				Segment_ = (Segment_ + 1) % CE_STREAM_RING_SEGMENTS;
+
+				auto& fence = Fences_[Segment_];
+				if (fence != nullptr)
+				{
+					// almost always signaled already, with three segments the GPU has two frames to catch up
+					if (glClientWaitSync(fence, 0, 0) == GL_TIMEOUT_EXPIRED)
+					{
+						++Stalls_;
+						while (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000) == GL_TIMEOUT_EXPIRED) {}
+					}
+
+					glDeleteSync(fence);
+					fence = nullptr;
+				}
+			}
+			else
+			{
+				Segment_ = (Segment_ + 1) % CE_STREAM_RING_SEGMENTS;
+
+				// wrapped around : orphan, the driver keeps the old storage alive for the pending draws
+				if (Segment_ == 0)
+				{
+					GLFunc::BindBuffer(Target_, Buffer_);
+					GLFunc::BufferData(Target_, SegmentSize_ * static_cast<GLsizeiptr>(CE_STREAM_RING_SEGMENTS), nullptr, GL_STREAM_DRAW);
+				}
+			}
+
+			Head_ = 0;
+		}
+	}
+}
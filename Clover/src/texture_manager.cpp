@@ -0,0 +1,222 @@
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+#include "headers/texture_manager.h"
+#include "headers/glFunc.h"
+
+namespace ce {
+	namespace Graphic {
+
+		/// <summary>
+		///		Constructor. The pixel buffers are created by init, once a context exists.
+		/// </summary>
+		TextureManager::TextureManager()
+			: Jobs_{ nullptr },
+			NextId_{ 0 },
+			Mutex_{},
+			Idle_{},
+			InFlight_{ 0 },
+			Decoded_{},
+			Pending_{},
+			Textures_{},
+			Ring_{},
+			ResidentBytes_{ 0 },
+			ClientUploads_{ 0 }
+		{}
+
+		/// <summary>
+		///		Destructor
+		/// </summary>
+		TextureManager::~TextureManager()
+		{
+			// the decode jobs push into this manager
+			{
+				std::unique_lock<std::mutex> lock{ Mutex_ };
+				Idle_.wait(lock, [this]() { return InFlight_ == 0; });
+			}
+
+			receive();
+			clear();
+		}
+
+		/// <summary>
+		///		Create the pixel buffer ring, one segment per frame of uploads
+		/// </summary>
+		void TextureManager::init()
+		{
+			Ring_.init(GL_PIXEL_UNPACK_BUFFER, CE_TEXTURE_RING_SEGMENT_SIZE);
+		}
+
+		/// <summary>
+		///		Start loading a texture
+		/// </summary>
+		/// <param name="path">BMP or PPM file</param>
+		/// <returns>Id of the texture, ready once decoded and uploaded</returns>
+		TextureId TextureManager::load(std::string const& path)
+		{
+			auto const id = NextId_.fetch_add(1, std::memory_order_relaxed);
+
+			{
+				std::lock_guard<std::mutex> lock{ Mutex_ };
+				++InFlight_;
+			}
+
+			auto decode = [this, id, path]() {
+				auto decoded = std::make_unique<Decoded>(Decoded{ id, Image{}, false });
+				decoded->valid = load_image(path, decoded->image);
+
+				// notified under the lock : the destructor may run as soon as InFlight_ reaches 0
+				std::lock_guard<std::mutex> lock{ Mutex_ };
+				Decoded_.push_back(std::move(decoded));
+
+				if (--InFlight_ == 0)
+					Idle_.notify_all();
+			};
+
+			if (Jobs_ == nullptr)
+				decode();
+			else
+				Jobs_->submit(decode);
+
+			return id;
+		}
+
+		/// <summary>
+		///		Upload the decoded textures, in decode order, until the frame budget is spent
+		/// </summary>
+		/// <param name="ready">Receives the ids of the textures made ready, the failed ones are not</param>
+		void TextureManager::update(std::vector<TextureId>& ready)
+		{
+			receive();
+
+			GLsizeiptr uploaded = 0;
+
+			while (!Pending_.empty())
+			{
+				auto& next = *Pending_.front();
+				auto const bytes = static_cast<GLsizeiptr>(next.image.pixels.size());
+
+				// at least one texture per frame, however large
+				if (uploaded > 0 && uploaded + bytes > CE_TEXTURE_UPLOAD_BUDGET)
+					break;
+
+				if (upload(next))
+					ready.push_back(next.id);
+
+				uploaded += bytes;
+				Pending_.pop_front();
+			}
+
+			// the GPU reads this frame's segment while the next uploads go to the following one
+			if (uploaded > 0 && Ring_.id() != 0)
+				Ring_.endFrame();
+		}
+
+		GLuint TextureManager::get(TextureId texture) const
+		{
+			return ready(texture) ? Textures_[texture].id : 0;
+		}
+
+		/// <summary>
+		///		Delete every texture
+		/// </summary>
+		void TextureManager::clear()
+		{
+			// the context may already be gone at shutdown, the textures went with it
+			if (GLFunc::IsReady())
+				for (auto const& t : Textures_)
+					if (t.id != 0)
+						GLFunc::DeleteTexture(t.id);
+
+			Textures_.clear();
+			Pending_.clear();
+			ResidentBytes_ = 0;
+		}
+
+		/// <summary>
+		///		Move the decoded textures from the queue to the upload list
+		/// </summary>
+		void TextureManager::receive()
+		{
+			std::lock_guard<std::mutex> lock{ Mutex_ };
+
+			for (auto& decoded : Decoded_)
+				Pending_.push_back(std::move(decoded));
+
+			Decoded_.clear();
+		}
+
+		/// <summary>
+		///		Create the texture and copy its pixels through the ring, then build the mip chain on the GPU
+		/// </summary>
+		/// <returns>False when the file could not be decoded</returns>
+		bool TextureManager::upload(Decoded& decoded)
+		{
+			if (decoded.id >= Textures_.size())
+				Textures_.resize(decoded.id + 1, Texture{ 0, 0, 0, 0, false, false });
+
+			auto& texture = Textures_[decoded.id];
+			auto const& image = decoded.image;
+
+			if (!decoded.valid)
+			{
+				texture.failed = true;
+				return false;
+			}
+
+			texture.width = image.width;
+			texture.height = image.height;
+
+			// a full mip chain costs a third of the base level
+			auto const bytes = image.pixels.size();
+			texture.bytes = bytes + bytes / 3;
+			ResidentBytes_ += texture.bytes;
+
+			// headless : nothing to upload
+			if (Ring_.id() == 0)
+			{
+				texture.ready = true;
+				return true;
+			}
+
+			auto levels = 1;
+			for (auto size = std::max(image.width, image.height); size > 1; size /= 2)
+				++levels;
+
+			texture.id = GLFunc::GenTexture();
+			GLFunc::BindTexture(0, GL_TEXTURE_2D, texture.id);
+
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levels - 1);
+			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, image.width, image.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+
+			auto const range = Ring_.allocate(static_cast<GLsizeiptr>(bytes), 4);
+
+			if (range.data != nullptr)
+			{
+				// the copy to the texture is a GPU side transfer from the pixel buffer
+				std::memcpy(range.data, image.pixels.data(), bytes);
+				Ring_.commit(range);
+
+				GLFunc::BindBuffer(GL_PIXEL_UNPACK_BUFFER, Ring_.id());
+				glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, image.width, image.height, GL_RGBA, GL_UNSIGNED_BYTE, reinterpret_cast<void*>(range.offset));
+				GLFunc::BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+			}
+			else
+			{
+				// larger than a ring segment : the driver copies from client memory
+				++ClientUploads_;
+				std::cerr << "Texture " << decoded.id << " (" << image.width << "x" << image.height
+					<< ") is larger than a pixel buffer segment, uploaded from client memory." << std::endl;
+
+				glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, image.width, image.height, GL_RGBA, GL_UNSIGNED_BYTE, image.pixels.data());
+			}
+
+			glGenerateMipmap(GL_TEXTURE_2D);
+			texture.ready = true;
+			return true;
+		}
+	}
+}
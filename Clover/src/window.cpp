@@ -1,204 +1,1137 @@
-﻿#include <iostream>
-
-#include "headers/window.h"
-#include "headers/glFunc.h"
-
-namespace ce {
-    namespace Graphic {
-
-        /// <summary>
-        ///     Constructor
-        /// </summary>
-        ceWindow::ceWindow(std::string title, std::size_t width, std::size_t height)
-            : Title_{ title }, Width_{ width }, Height_{ height }
-        {
-            ceRenderer_ = ceRenderer{ this };
-        }
-
-
-        /// <summary>
-        ///     Tells if the window is still open
-        /// </summary>
-        /// <returns> True or False </returns>
-        bool ceWindow::isOpen() {
-            return ceRenderer_.ContextIsRunning();
-        }
-
-        /// <summary>
-        ///     Get a pointer on the window renderer
-        /// </summary>
-        /// <returns> A pointer on the window renderer </returns>
-        ceWindow::ceRenderer* ceWindow::getRendererPtr() {
-            return &ceRenderer_;
-        }
-
-
-
-        /// <summary>
-        ///     Move constructor
-        /// </summary>
-        /// <param name="other"></param>
-        ceWindow::ceWindow(ceWindow&& other) noexcept
-            : Width_{ other.Width_ },
-            Height_{ other.Height_ },
-            Title_{ std::move(other.Title_) },
-            ceRenderer_{ std::move(other.ceRenderer_) }
-        {
-
-        }
-
-        /// <summary>
-        ///     Move assignement
-        /// </summary>
-        /// <param name="other"></param>
-        ceWindow& ceWindow::operator=(ceWindow&& other) noexcept
-        {
-            ceRenderer_ = std::move(other.ceRenderer_);
-            Width_ = other.Width_;
-            Height_ = other.Height_;
-            Title_ = std::move(other.Title_);
-
-            return *this;
-        }
-
-        /// <summary>
-        ///     Constructor
-        /// </summary>
-        /// <param name="w"> Parent window handle pointer </param>
-        ceWindow::ceRenderer::ceRenderer(ceWindow* w) {
-            WindowHndl_ = w;
-
-            ceWindow_ = GLFunc::CreateContextWindow(w->Title_, w->Width_, w->Height_);
-
-
-            // Projection matrix : 90° Field of View, 1/1 ratio, display range : 0.1 unit <-> 100 units
-            ProjectionMatrix_ = glm::perspective(glm::radians(90.0f), 1.0f, 0.1f, 100.0f);
-
-            // Camera matrix
-            CameraViewMatrix_ = glm::lookAt(
-                glm::vec3(0,0,1), // Camera is at (0,0,1), in World Space
-                glm::vec3(0, 0, 0), // and looks at the origin
-                glm::vec3(0, 1, 0)  // Head is up (set to 0,-1,0 to look upside-down)
-            );
-
-            ShaderProgramID_ = GLFunc::LoadStringShaders(CE_VERTEX_SHADER, CE_FRAGMENT_SHADER);
-            GLFunc::UseShader(ShaderProgramID_);
-
-            VAO_ID_ = GLFunc::GetVAO();
-        }
-
-        ceWindow::ceRenderer::ceRenderer()
-        : WindowHndl_{ nullptr },
-            ceWindow_{ nullptr },
-            ProjectionMatrix_{},
-            CameraViewMatrix_{},
-            ShaderProgramID_{},
-            VAO_ID_{0}
-         {
-            
-         }
-
-        /// <summary>
-        ///     Move constructor
-        /// </summary>
-        /// <param name="other"></param>
-        ceWindow::ceRenderer::ceRenderer(ceRenderer&& other) noexcept
-        : WindowHndl_{ other.WindowHndl_ },
-            ceWindow_{other.ceWindow_},
-            ProjectionMatrix_{other.ProjectionMatrix_},
-            CameraViewMatrix_{other.CameraViewMatrix_},
-            ShaderProgramID_{other.ShaderProgramID_},
-            VAO_ID_{other.VAO_ID_}
-        {}
-
-        /// <summary>
-        ///     Move assignement
-        /// </summary>
-        /// <param name="other"></param>
-        ceWindow::ceRenderer& ceWindow::ceRenderer::operator=(ceRenderer&& other) noexcept
-        {
-            WindowHndl_ = other.WindowHndl_;
-            ceWindow_ = other.ceWindow_;
-            ProjectionMatrix_ = other.ProjectionMatrix_;
-            CameraViewMatrix_ = other.CameraViewMatrix_;
-            ShaderProgramID_ = other.ShaderProgramID_;
-            VAO_ID_ = other.VAO_ID_;
-
-            return *this;
-        }
-
-        /// <summary>
-        ///     Draw backbuffer to screen
-        /// </summary>
-        void ceWindow::ceRenderer::draw() {
-
-            // Swap the buffers !
-            glfwSwapBuffers(ceWindow_);
-
-        }
-
-        /// <summary>
-        ///     Clear the window
-        /// </summary>
-        void ceWindow::ceRenderer::clear() {
-            GLFunc::ClearBuffers();
-        }
-
-        void ceWindow::ceRenderer::drawTriangle(Triangle t) {
-
-            
-            // Model matrix : an identity matrix (model will be at the origin)
-            glm::mat4 Model = CE_IDENTITY_MATRIX;
-
-            // Our ModelViewProjection : multiplication of our 3 matrices
-            glm::mat4 mvp = ProjectionMatrix_ * CameraViewMatrix_ * Model; // Remember, matrix multiplication is the other way around
-
-             // talk to our VAO
-            GLFunc::BindVAO(VAO_ID_);
-
-            // Get the shader
-            GLuint ShaderMatrixID_ = GLFunc::GetShaderMatrixID(ShaderProgramID_, "MVP");
-
-            // Send our transformation to the currently bound shader, in the "MVP" uniform
-            // This is done in the main loop since each model will have a different MVP matrix (At least for the M part)
-            GLFunc::BindShaderMatrixData(ShaderMatrixID_, &mvp[0][0]);
-
-            // enable the attributes array
-            GLFunc::EnableAttribute(0);
-
-            vertices v = vertices{
-                t.point_1.x, t.point_1.y, t.point_1.z,
-                t.point_2.x, t.point_2.y, t.point_2.z,
-                t.point_3.x, t.point_3.y, t.point_3.z
-            };
-
-            GLuint VBO_ID = GLFunc::BindVBO( VAO_ID_, v);
-
-            // Draw the triangle !
-            GLFunc::DrawArrays(GL_TRIANGLES, 0, v.size()/3); // Starting from vertex 0; 3 vertices total -> 1 triangle
-
-            // disable attributes and unbind to avoid errors
-            GLFunc::DisableAttribute(0);
-            GLFunc::UnbindVao();
-        }
-
-        bool ceWindow::ceRenderer::ContextIsRunning() {
-            return ceWindow_ != nullptr && !GLFunc::WindowShouldClose(ceWindow_);
-        }
-
-        GLFWwindow* ceWindow::ceRenderer::GetContextWindow()
-        {
-            return ceWindow_;
-        }
-
-        void ceWindow::ceRenderer::resize(int width, int height)
-        {
-            // just clear and swapbuffer
-            WindowHndl_->resize(width, height);
-            clear();
-            draw();
-        }
-
-    } // graphic namespace
-} // ce namespace
-
+﻿#include <algorithm>
+#include <assert.h>
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+
+#include "headers/window.h"
+#include "headers/core_components.h"
+#include "headers/glFunc.h"
+
+namespace ce {
+    namespace Graphic {
+
+        /// <summary>
+        ///     Constructor
+        /// </summary>
+        ceWindow::ceWindow(std::string title, std::size_t width, std::size_t height, RenderBackend backend)
+            : Title_{ title }, Width_{ width }, Height_{ height }, Backend_{ backend }
+        {
+            ceRenderer_ = ceRenderer{ this };
+        }
+
+
+        /// <summary>
+        ///     Tells if the window is still open
+        /// </summary>
+        /// <returns> True or False </returns>
+        bool ceWindow::isOpen() {
+            return ceRenderer_.ContextIsRunning();
+        }
+
+        /// <summary>
+        ///     Ask the window to close, isOpen returns false afterwards
+        /// </summary>
+        void ceWindow::close() {
+            ceRenderer_.close();
+        }
+
+        /// <summary>
+        ///     Get a pointer on the window renderer
+        /// </summary>
+        /// <returns> A pointer on the window renderer </returns>
+        ceWindow::ceRenderer* ceWindow::getRendererPtr() {
+            return &ceRenderer_;
+        }
+
+
+
+        /// <summary>
+        ///     Move constructor
+        /// </summary>
+        /// <param name="other"></param>
+        ceWindow::ceWindow(ceWindow&& other) noexcept
+            : ceRenderer_{ std::move(other.ceRenderer_) },
+            Width_{ other.Width_ },
+            Height_{ other.Height_ },
+            Title_{ std::move(other.Title_) },
+            Backend_{ other.Backend_ }
+        {
+
+        }
+
+        /// <summary>
+        ///     Move assignement
+        /// </summary>
+        /// <param name="other"></param>
+        ceWindow& ceWindow::operator=(ceWindow&& other) noexcept
+        {
+            ceRenderer_ = std::move(other.ceRenderer_);
+            Width_ = other.Width_;
+            Height_ = other.Height_;
+            Title_ = std::move(other.Title_);
+            Backend_ = other.Backend_;
+
+            return *this;
+        }
+
+        /// <summary>
+        ///     Constructor
+        /// </summary>
+        /// <param name="w"> Parent window handle pointer </param>
+        ceWindow::ceRenderer::ceRenderer(ceWindow* w)
+        : BatchProgram_{ nullptr },
+            MVP_{},
+            BatchRequest_{ CE_NO_SHADER_REQUEST },
+            Headless_{ w->Backend_ == RenderBackend::HEADLESS || w->Backend_ == RenderBackend::SOFTWARE },
+            Offscreen_{ w->Backend_ == RenderBackend::OFFSCREEN },
+            CloseRequested_{ false },
+            Stats_{},
+            Profiler_{},
+            Buffers_{},
+            Stream_{},
+            Target_{},
+            Batch_{},
+            DrawColor_{ BLUE },
+            Queue_{},
+            Layer_{ 0 },
+            Meshes_{},
+            InstancedProgramID_{ 0 },
+            InstancedProgram_{ nullptr },
+            VP_{},
+            InstancedRequest_{ CE_NO_SHADER_REQUEST },
+            Gathered_{},
+            Culling_{},
+            Bounded_{},
+            Visible_{},
+            MeshFirst_{},
+            MeshVertexCounts_{},
+            Frames_{},
+            Recording_{ 0 },
+            Thread_{},
+            Textures_{ std::make_unique<TextureManager>() },
+            TexturesReady_{},
+            Raster_{}
+        {
+            WindowHndl_ = w;
+
+            // Projection matrix : 90° Field of View, 1/1 ratio, display range : 0.1 unit <-> 100 units
+            ProjectionMatrix_ = glm::perspective(glm::radians(90.0f), 1.0f, 0.1f, 100.0f);
+
+            // Camera matrix
+            CameraViewMatrix_ = glm::lookAt(
+                glm::vec3(0,0,1), // Camera is at (0,0,1), in World Space
+                glm::vec3(0, 0, 0), // and looks at the origin
+                glm::vec3(0, 1, 0)  // Head is up (set to 0,-1,0 to look upside-down)
+            );
+
+            // a build machine without EGL still gets the counters
+            if (Offscreen_ && !GLFunc::CreateOffscreenContext())
+            {
+                std::cerr << "No offscreen context, the renderer runs headless." << std::endl;
+                Offscreen_ = false;
+                Headless_ = true;
+            }
+
+            // same when the driver rejects the framebuffer the frames would be drawn in
+            if (Offscreen_ && !Target_.create(static_cast<int>(w->Width_), static_cast<int>(w->Height_)))
+            {
+                std::cerr << "No offscreen render target, the renderer runs headless." << std::endl;
+                Offscreen_ = false;
+                Headless_ = true;
+            }
+
+            // the software backend is headless for GL, its draws go to the rasterizer
+            if (w->Backend_ == RenderBackend::SOFTWARE)
+                Raster_ = std::make_unique<SoftwareRasterizer>(static_cast<int>(w->Width_), static_cast<int>(w->Height_));
+
+            // no window, no context : nothing to load
+            if (Headless_)
+            {
+                ceWindow_ = nullptr;
+                ShaderProgramID_ = 0;
+                VAO_ID_ = 0;
+                return;
+            }
+
+            if (Offscreen_)
+            {
+                // the context has no default framebuffer, every frame is drawn in the target
+                ceWindow_ = nullptr;
+                Target_.bind();
+            }
+            else
+                ceWindow_ = GLFunc::CreateContextWindow(w->Title_, w->Width_, w->Height_);
+
+            // the programs compile while the first frames are drawn, the tiny fallback is the only wait.
+            // The sort keys use the program names, known before the link
+            BatchRequest_ = GLFunc::CompileShadersAsync(CE_VERTEX_SHADER, CE_FRAGMENT_SHADER);
+            ShaderProgramID_ = GLFunc::GetRequestProgramName(BatchRequest_);
+
+            auto const fallback = GLFunc::LoadStringShaders(CE_FALLBACK_VERTEX_SHADER, CE_FRAGMENT_SHADER);
+            GLFunc::UseShader(fallback);
+
+            // uniforms are found once here, the draws only use the handles
+            BatchProgram_ = GLFunc::GetProgram(fallback);
+            if (BatchProgram_ != nullptr)
+                MVP_ = BatchProgram_->uniform<glm::mat4>("MVP");
+
+            VAO_ID_ = GLFunc::GetVAO();
+
+            // the batches and the instances are streamed through one ring, the batch layout is recorded once in the VAO
+            Stream_.init(GL_ARRAY_BUFFER, CE_STREAM_SEGMENT_SIZE);
+
+            GLFunc::BindVAO(VAO_ID_);
+            GLFunc::BindBuffer(GL_ARRAY_BUFFER, Stream_.id());
+            GLFunc::VertexAttribPointer(0, 3, GL_FLOAT, sizeof(BatchVertex), offsetof(BatchVertex, x));
+            GLFunc::VertexAttribPointer(1, 4, GL_FLOAT, sizeof(BatchVertex), offsetof(BatchVertex, r));
+            GLFunc::EnableAttribute(0);
+            GLFunc::EnableAttribute(1);
+            GLFunc::UnbindVao();
+
+            // instanced meshes
+            InstancedRequest_ = GLFunc::CompileShadersAsync(CE_INSTANCED_VERTEX_SHADER, CE_FRAGMENT_SHADER);
+            InstancedProgramID_ = GLFunc::GetRequestProgramName(InstancedRequest_);
+
+            // programs from the cache are ready already
+            resolvePrograms();
+
+            // pixel buffers of the texture uploads
+            Textures_->init();
+
+            // timer queries of the passes
+            Profiler_.init();
+        }
+
+        ceWindow::ceRenderer::ceRenderer()
+        : WindowHndl_{ nullptr },
+            ceWindow_{ nullptr },
+            ProjectionMatrix_{},
+            CameraViewMatrix_{},
+            ShaderProgramID_{},
+            BatchProgram_{ nullptr },
+            MVP_{},
+            BatchRequest_{ CE_NO_SHADER_REQUEST },
+            VAO_ID_{0},
+            Headless_{ false },
+            Offscreen_{ false },
+            CloseRequested_{ false },
+            Stats_{},
+            Profiler_{},
+            Buffers_{},
+            Stream_{},
+            Target_{},
+            Batch_{},
+            DrawColor_{ BLUE },
+            Queue_{},
+            Layer_{ 0 },
+            Meshes_{},
+            InstancedProgramID_{ 0 },
+            InstancedProgram_{ nullptr },
+            VP_{},
+            InstancedRequest_{ CE_NO_SHADER_REQUEST },
+            Gathered_{},
+            Culling_{},
+            Bounded_{},
+            Visible_{},
+            MeshFirst_{},
+            MeshVertexCounts_{},
+            Frames_{},
+            Recording_{ 0 },
+            Thread_{},
+            Textures_{ std::make_unique<TextureManager>() },
+            TexturesReady_{},
+            Raster_{}
+         {
+            
+         }
+
+        /// <summary>
+        ///     Move constructor
+        /// </summary>
+        /// <param name="other"></param>
+        ceWindow::ceRenderer::ceRenderer(ceRenderer&& other) noexcept
+        : WindowHndl_{ other.WindowHndl_ },
+            ceWindow_{other.ceWindow_},
+            ProjectionMatrix_{other.ProjectionMatrix_},
+            CameraViewMatrix_{other.CameraViewMatrix_},
+            ShaderProgramID_{other.ShaderProgramID_},
+            BatchProgram_{other.BatchProgram_},
+            MVP_{other.MVP_},
+            BatchRequest_{other.BatchRequest_},
+            VAO_ID_{other.VAO_ID_},
+            Headless_{other.Headless_},
+            Offscreen_{other.Offscreen_},
+            CloseRequested_{other.CloseRequested_},
+            Stats_{other.Stats_},
+            Profiler_{std::move(other.Profiler_)},
+            Buffers_{std::move(other.Buffers_)},
+            Stream_{std::move(other.Stream_)},
+            Target_{std::move(other.Target_)},
+            Batch_{std::move(other.Batch_)},
+            DrawColor_{other.DrawColor_},
+            Queue_{std::move(other.Queue_)},
+            Layer_{other.Layer_},
+            Meshes_{std::move(other.Meshes_)},
+            InstancedProgramID_{other.InstancedProgramID_},
+            InstancedProgram_{other.InstancedProgram_},
+            VP_{other.VP_},
+            InstancedRequest_{other.InstancedRequest_},
+            Gathered_{std::move(other.Gathered_)},
+            Culling_{std::move(other.Culling_)},
+            Bounded_{std::move(other.Bounded_)},
+            Visible_{std::move(other.Visible_)},
+            MeshFirst_{std::move(other.MeshFirst_)},
+            MeshVertexCounts_{std::move(other.MeshVertexCounts_)},
+            Frames_{std::move(other.Frames_[0]), std::move(other.Frames_[1])},
+            Recording_{other.Recording_},
+            Thread_{},
+            Textures_{std::move(other.Textures_)},
+            TexturesReady_{std::move(other.TexturesReady_)},
+            Raster_{std::move(other.Raster_)}
+        {
+            // the render thread works on this object, it can not follow a move
+            assert(!other.Thread_ && "Stop the render thread before moving the renderer.");
+        }
+
+        /// <summary>
+        ///     Move assignement
+        /// </summary>
+        /// <param name="other"></param>
+        ceWindow::ceRenderer& ceWindow::ceRenderer::operator=(ceRenderer&& other) noexcept
+        {
+            // the render thread works on these objects, it can not follow a move
+            assert(!Thread_ && !other.Thread_ && "Stop the render thread before moving the renderer.");
+
+            WindowHndl_ = other.WindowHndl_;
+            ceWindow_ = other.ceWindow_;
+            ProjectionMatrix_ = other.ProjectionMatrix_;
+            CameraViewMatrix_ = other.CameraViewMatrix_;
+            ShaderProgramID_ = other.ShaderProgramID_;
+            BatchProgram_ = other.BatchProgram_;
+            MVP_ = other.MVP_;
+            BatchRequest_ = other.BatchRequest_;
+            VAO_ID_ = other.VAO_ID_;
+            Headless_ = other.Headless_;
+            Offscreen_ = other.Offscreen_;
+            CloseRequested_ = other.CloseRequested_;
+            Stats_ = other.Stats_;
+            Profiler_ = std::move(other.Profiler_);
+            Buffers_ = std::move(other.Buffers_);
+            Stream_ = std::move(other.Stream_);
+            Target_ = std::move(other.Target_);
+            Batch_ = std::move(other.Batch_);
+            DrawColor_ = other.DrawColor_;
+            Queue_ = std::move(other.Queue_);
+            Layer_ = other.Layer_;
+            Meshes_ = std::move(other.Meshes_);
+            InstancedProgramID_ = other.InstancedProgramID_;
+            InstancedProgram_ = other.InstancedProgram_;
+            VP_ = other.VP_;
+            InstancedRequest_ = other.InstancedRequest_;
+            Gathered_ = std::move(other.Gathered_);
+            Culling_ = std::move(other.Culling_);
+            Bounded_ = std::move(other.Bounded_);
+            Visible_ = std::move(other.Visible_);
+            MeshFirst_ = std::move(other.MeshFirst_);
+            MeshVertexCounts_ = std::move(other.MeshVertexCounts_);
+            Frames_[0] = std::move(other.Frames_[0]);
+            Frames_[1] = std::move(other.Frames_[1]);
+            Recording_ = other.Recording_;
+            Textures_ = std::move(other.Textures_);
+            TexturesReady_ = std::move(other.TexturesReady_);
+            Raster_ = std::move(other.Raster_);
+
+            return *this;
+        }
+
+        /// <summary>
+        ///     Destructor. Stop the render thread, the context comes back to this thread.
+        /// </summary>
+        ceWindow::ceRenderer::~ceRenderer() {
+            stopRenderThread();
+        }
+
+        /// <summary>
+        ///     Draw backbuffer to screen
+        /// </summary>
+        void ceWindow::ceRenderer::draw() {
+
+            ++Stats_.commands;
+            ++Stats_.submissions;
+
+            // the batched primitives must reach the back buffer before it is shown
+            submitBatch();
+            record(FrameOpType::PRESENT);
+
+            if (!Thread_) {
+                executeRecorded();
+                return;
+            }
+
+            // the render thread is done with the previous frame, its list records the next one
+            Thread_->wait();
+
+            auto& executed = Frames_[Recording_ ^ 1];
+            mergeStats(executed);
+            executed.clear();
+
+            Thread_->submit(&Frames_[Recording_]);
+            Recording_ ^= 1;
+        }
+
+        /// <summary>
+        ///     Clear the window
+        /// </summary>
+        void ceWindow::ceRenderer::clear() {
+            ++Stats_.commands;
+
+            // keep the submission order : what was drawn before the clear is cleared too
+            submitBatch();
+            record(FrameOpType::CLEAR);
+        }
+
+        /// <summary>
+        ///     Set the color used to clear the window
+        /// </summary>
+        void ceWindow::ceRenderer::setClearColor(color<float> clrcolor) {
+            ++Stats_.commands;
+
+            auto& op = record(FrameOpType::SET_CLEAR_COLOR);
+            op.clear_color = clrcolor;
+        }
+
+        /// <summary>
+        ///     Add a triangle to the batch, in the current draw color
+        /// </summary>
+        void ceWindow::ceRenderer::drawTriangle(Triangle t) {
+
+            ++Stats_.commands;
+            ++Stats_.triangles;
+
+            reserveBatch(BatchPrimitive::TRIANGLES, 3);
+            Batch_.triangle(t.point_1, t.point_2, t.point_3, DrawColor_);
+        }
+
+        /// <summary>
+        ///     Add a quad to the batch, drawn as two triangles
+        /// </summary>
+        void ceWindow::ceRenderer::drawQuad(Quad q) {
+
+            ++Stats_.commands;
+            Stats_.triangles += 2;
+
+            reserveBatch(BatchPrimitive::TRIANGLES, 6);
+            Batch_.quad(q.point_1, q.point_2, q.point_3, q.point_4, DrawColor_);
+        }
+
+        /// <summary>
+        ///     Add a line segment to the batch
+        /// </summary>
+        void ceWindow::ceRenderer::drawLine(Line l) {
+
+            ++Stats_.commands;
+
+            reserveBatch(BatchPrimitive::LINES, 2);
+            Batch_.line(l.point_1, l.point_2, DrawColor_);
+        }
+
+        /// <summary>
+        ///     Draw everything submitted so far. With a render thread it happens
+        ///     on that thread, when the frame is executed.
+        /// </summary>
+        void ceWindow::ceRenderer::flush() {
+            submitBatch();
+            record(FrameOpType::FLUSH);
+
+            if (!Thread_)
+                executeRecorded();
+        }
+
+        /// <summary>
+        ///     Start a new layer, the draws of lower layers are executed first
+        /// </summary>
+        void ceWindow::ceRenderer::setLayer(std::uint8_t layer) {
+            if (layer != Layer_)
+                submitBatch();
+
+            Layer_ = layer;
+        }
+
+        /// <summary>
+        ///     Register a mesh for the instanced path. The upload is recorded with the frame.
+        /// </summary>
+        /// <param name="positions">Triangle list, 3 points per triangle</param>
+        /// <returns>Id to put in the Renderable components</returns>
+        MeshId ceWindow::ceRenderer::addMesh(std::vector<ce::Core::fVec3> const& positions) {
+
+            auto& frame = recording();
+            auto& op = record(FrameOpType::UPLOAD_MESH);
+            op.mesh = MeshVertexCounts_.size();
+            op.first = frame.mesh_vertices.size();
+            op.count = positions.size();
+
+            frame.mesh_vertices.insert(frame.mesh_vertices.end(), positions.begin(), positions.end());
+            MeshVertexCounts_.push_back(static_cast<GLsizei>(positions.size()));
+
+            return op.mesh;
+        }
+
+        /// <summary>
+        ///     Start loading a texture. The upload happens on the thread executing the frames,
+        ///     spread over several frames when many textures arrive together.
+        /// </summary>
+        /// <param name="path">BMP or binary PPM file</param>
+        /// <returns>Id of the texture, usable before the texture is ready</returns>
+        TextureId ceWindow::ceRenderer::loadTexture(std::string const& path) {
+            return Textures_->load(path);
+        }
+
+        /// <summary>
+        ///     Tell if a texture was uploaded by the frames executed so far.
+        ///     With the render thread, the answer lags the uploads by a frame.
+        /// </summary>
+        bool ceWindow::ceRenderer::textureReady(TextureId texture) const {
+            return texture < TexturesReady_.size() && TexturesReady_[texture];
+        }
+
+        /// <summary>
+        ///     Bind a texture for the draws recorded after this call. Recorded like the draws :
+        ///     the manager is only read by the thread executing the frames.
+        /// </summary>
+        /// <param name="texture">Id from loadTexture, unbinds the unit until the texture is ready</param>
+        /// <param name="unit">Texture unit</param>
+        void ceWindow::ceRenderer::bindTexture(TextureId texture, GLuint unit) {
+
+            // the batched primitives are drawn with the previous binding
+            submitBatch();
+
+            auto& op = record(FrameOpType::BIND_TEXTURE);
+            op.first = texture;
+            op.count = unit;
+        }
+
+        /// <summary>
+        ///     Jobs decoding the textures, and rasterizing the tiles of the software backend
+        /// </summary>
+        /// <param name="jobs">Null to do the work on the thread executing the frames</param>
+        void ceWindow::ceRenderer::setJobSystem(ce::Core::JobSystem* jobs) {
+            Textures_->setJobSystem(jobs);
+
+            if (Raster_)
+                Raster_->setJobSystem(jobs);
+        }
+
+        /// <summary>
+        ///     Register a baked indexed mesh. The file is mapped here and uploaded
+        ///     from the mapping when the frame is executed, without parsing nor copy.
+        /// </summary>
+        /// <param name="path">File written by bake_obj</param>
+        /// <returns>Id to put in the Renderable components, CE_INVALID_MESH if the file is not valid</returns>
+        MeshId ceWindow::ceRenderer::loadMesh(std::string const& path) {
+
+            auto file = std::make_shared<MeshFile>(path);
+
+            if (!file->isOpen())
+                return CE_INVALID_MESH;
+
+            auto const data = file->data();
+            auto& frame = recording();
+            auto& op = record(FrameOpType::UPLOAD_MESH_FILE);
+            op.mesh = MeshVertexCounts_.size();
+            op.first = frame.mesh_files.size();
+
+            frame.mesh_files.push_back(std::move(file));
+            MeshVertexCounts_.push_back(static_cast<GLsizei>(data.indices != nullptr ? data.index_count : data.vertex_count));
+
+            return op.mesh;
+        }
+
+        /// <summary>
+        ///     Draw every entity with a Node and a Renderable. Entities with Bounds outside of the view
+        ///     are culled, the others are grouped by mesh, copied in the frame at once, then each mesh
+        ///     is queued as a single instanced draw.
+        /// </summary>
+        /// <param name="store">Store holding the components</param>
+        void ceWindow::ceRenderer::drawEntities(ce::Core::Store& store) {
+
+            ++Stats_.commands;
+
+            Gathered_.clear();
+            Culling_.clear();
+            Bounded_.clear();
+
+            store.ForEach<ce::Core::Renderable>(ce::Core::RENDERABLE_TYPE, [&](ce::Core::Entity owner, ce::Core::Renderable& r) {
+                auto node = store.Get<ce::Core::Node>(ce::Core::NODE_TYPE, owner);
+
+                if (node == nullptr || r.mesh >= MeshVertexCounts_.size())
+                    return;
+
+                if (auto bounds = store.Get<ce::Core::Bounds>(ce::Core::BOUNDS_TYPE, owner); bounds != nullptr) {
+                    Culling_.add(ce::Core::fVec3{ node->x, node->y, node->z }, bounds->radius, bounds->half_extents);
+                    Bounded_.push_back(Gathered_.size());
+                }
+
+                auto const model = glm::translate(CE_IDENTITY_MATRIX, glm::vec3(node->x, node->y, node->z));
+                Gathered_.emplace_back(r.mesh, InstanceData{ model, r.tint });
+            });
+
+            if (Gathered_.empty())
+                return;
+
+            if (Culling_.size() > 0) {
+                Visible_.clear();
+                Culling_.cull(extract_frustum(ProjectionMatrix_ * CameraViewMatrix_), Visible_);
+
+                // the visible indices are sorted : walk both lists, the instances left out lose their mesh
+                std::size_t v = 0;
+                for (std::size_t b = 0; b < Bounded_.size(); ++b) {
+                    if (v < Visible_.size() && Visible_[v] == b)
+                        ++v;
+                    else
+                        Gathered_[Bounded_[b]].first = CE_INVALID_MESH;
+                }
+
+                Stats_.culled += Bounded_.size() - Visible_.size();
+            }
+
+            // counting sort by mesh : the instances of a mesh end up contiguous
+            MeshFirst_.assign(MeshVertexCounts_.size() + 1, 0);
+
+            for (auto const& gathered : Gathered_)
+                if (gathered.first != CE_INVALID_MESH)
+                    ++MeshFirst_[gathered.first + 1];
+
+            for (std::size_t m = 1; m < MeshFirst_.size(); ++m)
+                MeshFirst_[m] += MeshFirst_[m - 1];
+
+            if (MeshFirst_.back() == 0)
+                return;
+
+            auto& frame = recording();
+            auto const base = frame.instances.size();
+            frame.instances.resize(base + MeshFirst_.back());
+            {
+                auto cursor = MeshFirst_;
+                for (auto const& [mesh, instance] : Gathered_)
+                    if (mesh != CE_INVALID_MESH)
+                        frame.instances[base + cursor[mesh]++] = instance;
+            }
+
+            frame.transforms.push_back(ProjectionMatrix_ * CameraViewMatrix_);
+            auto const vp = static_cast<std::uint32_t>(frame.transforms.size() - 1);
+
+            for (MeshId m = 0; m < MeshVertexCounts_.size(); ++m) {
+                auto const count = MeshFirst_[m + 1] - MeshFirst_[m];
+
+                if (count == 0)
+                    continue;
+
+                Stats_.triangles += count * (MeshVertexCounts_[m] / 3);
+
+                // the VAO of a mesh only exists on the executing side, the mesh id groups the same draws
+                auto& op = record(FrameOpType::DRAW_INSTANCED);
+                op.key = make_sort_key(Layer_, InstancedProgramID_, static_cast<std::uint32_t>(m), static_cast<GLuint>(m), 0.0f);
+                op.mode = GL_TRIANGLES;
+                op.mesh = m;
+                op.first = base + MeshFirst_[m];
+                op.count = count;
+                op.transform = vp;
+            }
+        }
+
+        /// <summary>
+        ///     Run the render thread : every GL call of the renderer moves to it,
+        ///     draw() hands the recorded frame over and returns to record the next one.
+        /// </summary>
+        void ceWindow::ceRenderer::startRenderThread() {
+
+            if (Thread_)
+                return;
+
+            // what was recorded so far is drawn with the context still here
+            flush();
+
+            if (!Headless_)
+                GLFunc::ReleaseContext();
+
+            Thread_ = std::make_unique<RenderThread>(
+                [this]() { makeCurrent(); },
+                [this](FrameList& frame) { executeFrame(frame); },
+                [this]() { if (!Headless_) GLFunc::ReleaseContext(); });
+        }
+
+        /// <summary>
+        ///     Finish the frame in flight, stop the render thread and take the context back
+        /// </summary>
+        void ceWindow::ceRenderer::stopRenderThread() {
+
+            if (!Thread_)
+                return;
+
+            Thread_->wait();
+            Thread_.reset();
+
+            auto& executed = Frames_[Recording_ ^ 1];
+            mergeStats(executed);
+            executed.clear();
+
+            makeCurrent();
+        }
+
+        /// <summary>
+        ///     Make the context of the renderer current on the calling thread
+        /// </summary>
+        void ceWindow::ceRenderer::makeCurrent() {
+            if (Offscreen_)
+                GLFunc::SetOffscreenContext();
+            else if (!Headless_)
+                GLFunc::SetContextWindow(ceWindow_);
+        }
+
+        /// <summary>
+        ///     Read back the last frame drawn offscreen or in software, to save it or compare it to a reference
+        /// </summary>
+        /// <param name="image">Receives the RGBA pixels, rows bottom up</param>
+        /// <returns>False when the renderer does not draw offscreen nor in software</returns>
+        bool ceWindow::ceRenderer::capture(Image& image) {
+            assert(!Thread_ && "Stop the render thread before reading the frames back.");
+
+            if (Raster_)
+                return Raster_->read(image);
+
+            if (!Offscreen_)
+                return false;
+
+            return Target_.read(image);
+        }
+
+        /// <summary>
+        ///     Turn the batched primitives into a single draw operation
+        /// </summary>
+        void ceWindow::ceRenderer::submitBatch() {
+
+            if (Batch_.empty())
+                return;
+
+            auto& frame = recording();
+            auto const& v = Batch_.vertices();
+
+            // Model matrix : an identity matrix (model will be at the origin)
+            glm::mat4 Model = CE_IDENTITY_MATRIX;
+
+            // Our ModelViewProjection : multiplication of our 3 matrices
+            frame.transforms.push_back(ProjectionMatrix_ * CameraViewMatrix_ * Model); // Remember, matrix multiplication is the other way around
+
+            auto& op = record(FrameOpType::DRAW_BATCH);
+            op.key = make_sort_key(Layer_, ShaderProgramID_, 0, VAO_ID_, 0.0f);
+            op.mode = Batch_.primitive() == BatchPrimitive::LINES ? GL_LINES : GL_TRIANGLES;
+            op.first = frame.vertices.size();
+            op.count = v.size();
+            op.transform = static_cast<std::uint32_t>(frame.transforms.size() - 1);
+
+            frame.vertices.insert(frame.vertices.end(), v.begin(), v.end());
+            Batch_.clear();
+        }
+
+        /// <summary>
+        ///     Append an operation to the frame being recorded
+        /// </summary>
+        FrameOp& ceWindow::ceRenderer::record(FrameOpType type) {
+            auto& ops = recording().ops;
+            ops.push_back(FrameOp{ type, 0, GL_TRIANGLES, CE_INVALID_MESH, 0, 0, CE_NO_TRANSFORM, color<float>{} });
+            return ops.back();
+        }
+
+        /// <summary>
+        ///     Execute the recorded operations on this thread
+        /// </summary>
+        void ceWindow::ceRenderer::executeRecorded() {
+            auto& frame = recording();
+            executeFrame(frame);
+            mergeStats(frame);
+            frame.clear();
+        }
+
+        /// <summary>
+        ///     Add the counters of an executed frame to the renderer stats, and learn its ready textures
+        /// </summary>
+        void ceWindow::ceRenderer::mergeStats(FrameList const& frame) {
+            Stats_.draw_calls += frame.draw_calls;
+            Stats_.state_changes += frame.state_changes;
+            Stats_.redundant_calls += frame.redundant_calls;
+
+            for (auto const texture : frame.textures_ready) {
+                if (texture >= TexturesReady_.size())
+                    TexturesReady_.resize(texture + 1, false);
+
+                TexturesReady_[texture] = true;
+            }
+        }
+
+        /// <summary>
+        ///     Replay a recorded frame. Every GL call of the renderer happens here,
+        ///     on the thread owning the context.
+        /// </summary>
+        /// <param name="frame">Recorded frame, its counters are filled</param>
+        void ceWindow::ceRenderer::executeFrame(FrameList& frame) {
+
+            // a frame list executed by flush continues the frame, PRESENT ends it
+            Profiler_.beginFrame();
+
+            for (auto const& op : frame.ops) {
+                switch (op.type) {
+
+                case FrameOpType::UPLOAD_MESH: {
+                    ProfileZone zone{ Profiler_, "uploads" };
+                    std::vector<ce::Core::fVec3> positions(frame.mesh_vertices.begin() + op.first, frame.mesh_vertices.begin() + op.first + op.count);
+                    auto const id = Meshes_.add(positions, Headless_ ? nullptr : &Buffers_);
+                    assert(id == op.mesh && "Mesh ids differ between recording and execution.");
+
+                    if (Raster_)
+                        Raster_->addMesh(MeshData{ positions.data(), positions.size(), nullptr, 0, 0 });
+                    break;
+                }
+
+                case FrameOpType::UPLOAD_MESH_FILE: {
+                    ProfileZone zone{ Profiler_, "uploads" };
+                    auto const id = Meshes_.add(frame.mesh_files[op.first]->data(), Headless_ ? nullptr : &Buffers_);
+                    assert(id == op.mesh && "Mesh ids differ between recording and execution.");
+
+                    if (Raster_)
+                        Raster_->addMesh(frame.mesh_files[op.first]->data());
+                    break;
+                }
+
+                case FrameOpType::SET_CLEAR_COLOR:
+                    if (!Headless_)
+                        GLFunc::ClearColor(op.clear_color.r, op.clear_color.g, op.clear_color.b, op.clear_color.a);
+                    else if (Raster_)
+                        Raster_->setClearColor(op.clear_color);
+                    break;
+
+                case FrameOpType::CLEAR:
+                    executeQueue(frame);
+                    if (!Headless_)
+                        GLFunc::ClearBuffers();
+                    else if (Raster_)
+                        Raster_->clear();
+                    break;
+
+                case FrameOpType::DRAW_BATCH:
+                    queueBatch(frame, op);
+                    break;
+
+                case FrameOpType::DRAW_INSTANCED:
+                    queueInstances(frame, op);
+                    break;
+
+                case FrameOpType::BIND_TEXTURE:
+                    // the queued draws keep the previous binding
+                    executeQueue(frame);
+                    if (!Headless_)
+                        GLFunc::BindTexture(static_cast<GLuint>(op.count), GL_TEXTURE_2D, Textures_->get(static_cast<TextureId>(op.first)));
+                    break;
+
+                case FrameOpType::FLUSH:
+                    executeQueue(frame);
+                    break;
+
+                case FrameOpType::PRESENT:
+                    executeQueue(frame);
+
+                    // upload the textures decoded since the last frame, within the budget
+                    {
+                        ProfileZone zone{ Profiler_, "textures" };
+                        Textures_->update(frame.textures_ready);
+                    }
+
+                    if (!Headless_) {
+                        // a long present is a CPU waiting for the GPU
+                        ProfileZone zone{ Profiler_, "present" };
+
+                        // fence the streamed data of this frame
+                        Stream_.endFrame();
+
+                        // advance the asynchronous shader compilations, the next frames draw with the finished ones
+                        GLFunc::PollShaders();
+                        resolvePrograms();
+
+                        // Swap the buffers ! Offscreen frames stay in the render target
+                        if (ceWindow_ != nullptr)
+                            glfwSwapBuffers(ceWindow_);
+                    }
+
+                    Profiler_.endFrame();
+                    break;
+                }
+            }
+
+            // the GLFunc counters cover the calls made by this frame only
+            if (!Headless_) {
+                frame.redundant_calls += GLFunc::StateStats().skipped;
+                GLFunc::ResetStateStats();
+            }
+        }
+
+        /// <summary>
+        ///     Take over the programs whose compilation finished. A failed batch program keeps the fallback,
+        ///     a failed instanced one leaves the instances undrawn.
+        /// </summary>
+        void ceWindow::ceRenderer::resolvePrograms() {
+
+            if (BatchRequest_ != CE_NO_SHADER_REQUEST && GLFunc::GetShaderStatus(BatchRequest_) != GLFunc::ShaderStatus::PENDING) {
+                auto const program = GLFunc::GetProgram(GLFunc::GetRequestProgram(BatchRequest_));
+                BatchRequest_ = CE_NO_SHADER_REQUEST;
+
+                if (program != nullptr) {
+                    BatchProgram_ = program;
+                    MVP_ = BatchProgram_->uniform<glm::mat4>("MVP");
+                }
+                else
+                    std::cerr << "The batch program did not link, the batches keep the fallback." << std::endl;
+            }
+
+            if (InstancedRequest_ != CE_NO_SHADER_REQUEST && GLFunc::GetShaderStatus(InstancedRequest_) != GLFunc::ShaderStatus::PENDING) {
+                auto const program = GLFunc::GetProgram(GLFunc::GetRequestProgram(InstancedRequest_));
+                InstancedRequest_ = CE_NO_SHADER_REQUEST;
+
+                if (program != nullptr) {
+                    InstancedProgram_ = program;
+                    VP_ = InstancedProgram_->uniform<glm::mat4>("VP");
+                }
+                else
+                    std::cerr << "The instanced program did not link, the instances are not drawn." << std::endl;
+            }
+        }
+
+        /// <summary>
+        ///     Stream the vertices of a recorded batch and queue its draw
+        /// </summary>
+        void ceWindow::ceRenderer::queueBatch(FrameList& frame, FrameOp const& op) {
+
+            RenderCommand command{};
+            command.key = op.key;
+            command.shader = BatchProgram_;
+            command.transform = MVP_;
+            command.transform_index = CE_NO_TRANSFORM;
+            command.vao = VAO_ID_;
+            command.mode = op.mode;
+            command.first = 0;
+            command.count = static_cast<GLsizei>(op.count);
+            command.index_type = 0;
+            command.instances = 0;
+            command.mesh = CE_INVALID_MESH;
+            command.instance_offset = 0;
+
+            if (Raster_) {
+                // the rasterizer reads the vertices from the frame list
+                command.transform_index = Queue_.pushTransform(frame.transforms[op.transform]);
+                command.first = static_cast<GLint>(op.first);
+            }
+            else if (!Headless_) {
+                command.transform_index = Queue_.pushTransform(frame.transforms[op.transform]);
+
+                // copy the whole batch in the ring, aligned on a vertex so it is drawn from its first vertex
+                auto const bytes = op.count * sizeof(BatchVertex);
+
+                // the queued draws read the current segment : issue them before the ring leaves it
+                if (!Stream_.fits(bytes, sizeof(BatchVertex)))
+                    executeQueue(frame);
+
+                auto const range = Stream_.allocate(bytes, sizeof(BatchVertex));
+
+                if (range.data == nullptr)
+                    return;
+
+                std::memcpy(range.data, &frame.vertices[op.first], bytes);
+                Stream_.commit(range);
+                command.first = static_cast<GLint>(range.offset / sizeof(BatchVertex));
+            }
+
+            Queue_.submit(command);
+        }
+
+        /// <summary>
+        ///     Stream the instances of a mesh and queue its instanced draw
+        /// </summary>
+        void ceWindow::ceRenderer::queueInstances(FrameList& frame, FrameOp const& op) {
+
+            if (!Meshes_.valid(op.mesh))
+                return;
+
+            // the instance layout needs the real program, the batch fallback can not draw it
+            if (!Headless_ && InstancedProgram_ == nullptr)
+                return;
+
+            auto const& mesh = Meshes_.get(op.mesh);
+
+            RenderCommand command{};
+            command.key = op.key;
+            command.shader = InstancedProgram_;
+            command.transform = VP_;
+            command.transform_index = Headless_ && !Raster_ ? CE_NO_TRANSFORM : Queue_.pushTransform(frame.transforms[op.transform]);
+            command.vao = mesh.vao;
+            command.mode = op.mode;
+            command.first = 0;
+            command.count = mesh.element_count();
+            command.index_type = mesh.index_type;
+            command.instances = static_cast<GLsizei>(op.count);
+            command.mesh = op.mesh;
+            command.instance_offset = 0;
+
+            if (Headless_) {
+                // the rasterizer reads the instances from the frame list
+                if (Raster_)
+                    command.instance_offset = static_cast<GLintptr>(op.first);
+
+                Queue_.submit(command);
+                return;
+            }
+
+            // one draw per mesh, unless its instances do not fit a ring segment
+            auto const chunk = static_cast<std::size_t>((Stream_.segmentSize() - 16) / sizeof(InstanceData));
+            auto const end = op.first + op.count;
+
+            for (auto first = op.first; first < end; first += chunk) {
+                auto const n = std::min(chunk, end - first);
+
+                // the queued draws read the current segment : issue them before the ring leaves it
+                if (!Stream_.fits(n * sizeof(InstanceData), 16))
+                    executeQueue(frame);
+
+                auto const range = Stream_.allocate(n * sizeof(InstanceData), 16);
+
+                if (range.data == nullptr)
+                    break;
+
+                std::memcpy(range.data, &frame.instances[first], n * sizeof(InstanceData));
+                Stream_.commit(range);
+
+                command.instances = static_cast<GLsizei>(n);
+                command.instance_offset = range.offset;
+                Queue_.submit(command);
+            }
+        }
+
+        /// <summary>
+        ///     Sort the queued commands and draw them, binding a program or a VAO only when it changes
+        /// </summary>
+        void ceWindow::ceRenderer::executeQueue(FrameList& frame) {
+
+            if (Queue_.empty())
+                return;
+
+            ProfileZone zone{ Profiler_, "draws" };
+
+            Queue_.sort();
+
+            ShaderProgram* shader = nullptr;
+            GLuint vao = 0;
+
+            Queue_.execute([&](RenderCommand const& c) {
+                ++frame.draw_calls;
+
+                if (c.shader != shader || c.vao != vao)
+                    ++frame.state_changes;
+
+                if (Raster_) {
+                    rasterize(frame, c);
+                    return;
+                }
+
+                if (Headless_)
+                    return;
+
+                if (c.shader != shader) {
+                    shader = c.shader;
+                    if (shader != nullptr)
+                        GLFunc::UseShader(shader->id());
+                }
+
+                if (shader != nullptr && c.transform_index != CE_NO_TRANSFORM)
+                    shader->set(c.transform, Queue_.transform(c.transform_index));
+
+                if (c.instances > 0) {
+                    // the instance attributes of the mesh VAO move to the range of this draw
+                    Meshes_.bindInstances(c.mesh, Stream_.id(), c.instance_offset);
+
+                    if (c.index_type != 0)
+                        GLFunc::DrawElementsInstanced(c.mode, c.count, c.index_type, 0, c.instances);
+                    else
+                        GLFunc::DrawArraysInstanced(c.mode, c.first, c.count, c.instances);
+                }
+                else {
+                    GLFunc::BindVAO(c.vao);
+
+                    if (c.index_type != 0)
+                        GLFunc::DrawElements(c.mode, c.count, c.index_type, c.first * (c.index_type == GL_UNSIGNED_SHORT ? sizeof(GLushort) : sizeof(GLuint)));
+                    else
+                        GLFunc::DrawArrays(c.mode, c.first, c.count);
+                }
+
+                vao = c.vao;
+            });
+
+            Queue_.clear();
+
+            if (Raster_) {
+                ProfileZone raster{ Profiler_, "raster" };
+                Raster_->flush();
+            }
+        }
+
+        /// <summary>
+        ///     Hand a sorted command to the software rasterizer. Lines are not drawn.
+        /// </summary>
+        void ceWindow::ceRenderer::rasterize(FrameList const& frame, RenderCommand const& c) {
+
+            if (c.mode != GL_TRIANGLES)
+                return;
+
+            auto const& transform = Queue_.transform(c.transform_index);
+
+            if (c.instances > 0)
+                Raster_->drawInstances(c.mesh, transform, &frame.instances[static_cast<std::size_t>(c.instance_offset)], static_cast<std::size_t>(c.instances));
+            else
+                Raster_->drawBatch(&frame.vertices[static_cast<std::size_t>(c.first)], static_cast<std::size_t>(c.count), transform);
+        }
+
+        /// <summary>
+        ///     Flush the batch when the next primitive can not join it
+        /// </summary>
+        void ceWindow::ceRenderer::reserveBatch(BatchPrimitive primitive, std::size_t vertex_count) {
+            if (Batch_.needsFlush(primitive, vertex_count))
+                submitBatch();
+        }
+
+        bool ceWindow::ceRenderer::ContextIsRunning() {
+            if (Headless_ || Offscreen_)
+                return !CloseRequested_;
+
+            return ceWindow_ != nullptr && !GLFunc::WindowShouldClose(ceWindow_);
+        }
+
+        void ceWindow::ceRenderer::close() {
+            CloseRequested_ = true;
+
+            if (ceWindow_ != nullptr)
+                glfwSetWindowShouldClose(ceWindow_, GLFW_TRUE);
+        }
+
+        GLFWwindow* ceWindow::ceRenderer::GetContextWindow()
+        {
+            return ceWindow_;
+        }
+
+        void ceWindow::ceRenderer::resize(int width, int height)
+        {
+            // just clear and swapbuffer
+            WindowHndl_->resize(width, height);
+            clear();
+            draw();
+        }
+
+    } // graphic namespace
+} // ce namespace
+